@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Boot time benchmarks of the sensor kernels.
+ *
+ * A benchmark runs once at boot, after the kernel has started, with the timing functions
+ * running. It compares variants of a kernel on the same random input and logs the cycles
+ * each takes.
+ */
+
+#ifndef BENCHMARK_H__
+#define BENCHMARK_H__
+
+#include <zephyr/init.h>
+#include <zephyr/timing/timing.h>
+
+#include "xorshift.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Run a statement and add the cycles it took to a counter.
+ *
+ * @param cycles uint64_t counter.
+ * @param stmt Statement to time.
+ */
+#define BENCHMARK_TIME(cycles, stmt)                                                               \
+	do {                                                                                       \
+		timing_t _start = timing_counter_get();                                            \
+		stmt;                                                                              \
+		timing_t _end = timing_counter_get();                                              \
+		(cycles) += timing_cycles_get(&_start, &_end);                                     \
+	} while (0)
+
+/**
+ * @brief Run a benchmark once at boot.
+ *
+ * @param fn Benchmark, void fn(void).
+ */
+#define BENCHMARK_DEFINE(fn)                                                                       \
+	static int fn##_run(void)                                                                  \
+	{                                                                                          \
+		timing_init();                                                                     \
+		timing_start();                                                                    \
+		fn();                                                                              \
+		timing_stop();                                                                     \
+		return 0;                                                                          \
+	}                                                                                          \
+	SYS_INIT(fn##_run, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCHMARK_H__ */
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#if defined(CONFIG_EXTERNAL_SENSORS_BLOCK_FILTER_DSP)
+#include <cmsis_core.h>
+#endif
+
+#include "block_filter.h"
+
+/* Sums are exact in both variants, so they give bit-identical results. */
+struct block_sums {
+	int32_t sum;
+	int64_t sum_squares;
+};
+
+static __maybe_unused void block_sums_scalar(const int16_t *data, size_t count,
+					     struct block_sums *sums)
+{
+	int32_t sum = 0;
+	int64_t sum_squares = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		sum += data[i];
+		sum_squares += (int32_t)data[i] * data[i];
+	}
+
+	sums->sum = sum;
+	sums->sum_squares = sum_squares;
+}
+
+#if defined(CONFIG_EXTERNAL_SENSORS_BLOCK_FILTER_DSP)
+/* Two samples per instruction with the DSP extension: SMLAD adds both halfwords of a
+ * word to the sum and SMLALD adds both their squares to the 64-bit sum of squares.
+ */
+static void block_sums_dsp(const int16_t *data, size_t count, struct block_sums *sums)
+{
+	int32_t sum = 0;
+	int64_t sum_squares = 0;
+	size_t i;
+
+	for (i = 0; i + 1 < count; i += 2) {
+		uint32_t pair;
+
+		memcpy(&pair, &data[i], sizeof(pair));
+		sum = __SMLAD(pair, 0x00010001, sum);
+		sum_squares = __SMLALD(pair, pair, sum_squares);
+	}
+
+	if (i < count) {
+		sum += data[i];
+		sum_squares += (int32_t)data[i] * data[i];
+	}
+
+	sums->sum = sum;
+	sums->sum_squares = sum_squares;
+}
+#endif /* defined(CONFIG_EXTERNAL_SENSORS_BLOCK_FILTER_DSP) */
+
+static void block_sums_get(const int16_t *data, size_t count, struct block_sums *sums)
+{
+#if defined(CONFIG_EXTERNAL_SENSORS_BLOCK_FILTER_DSP)
+	block_sums_dsp(data, count, sums);
+#else
+	block_sums_scalar(data, count, sums);
+#endif
+}
+
+int16_t block_filter_mean(const int16_t *data, size_t count)
+{
+	struct block_sums sums;
+
+	block_sums_get(data, count, &sums);
+
+	return sums.sum / (int32_t)count;
+}
+
+uint32_t block_filter_variance(const int16_t *data, size_t count)
+{
+	struct block_sums sums;
+	int64_t n = count;
+
+	block_sums_get(data, count, &sums);
+
+	return (n * sums.sum_squares - (int64_t)sums.sum * sums.sum) / (n * n);
+}
+
+static void swap(int16_t *a, int16_t *b)
+{
+	int16_t tmp = *a;
+
+	*a = *b;
+	*b = tmp;
+}
+
+/* Quickselect, leaves the k-th smallest sample at data[k] and smaller ones before it. */
+static int16_t select_kth(int16_t *data, size_t count, size_t k)
+{
+	size_t left = 0;
+	size_t right = count - 1;
+
+	while (left < right) {
+		int16_t pivot = data[left + (right - left) / 2];
+		size_t i = left;
+		size_t j = right;
+
+		while (i <= j) {
+			while (data[i] < pivot) {
+				i++;
+			}
+			while (data[j] > pivot) {
+				j--;
+			}
+			if (i <= j) {
+				swap(&data[i], &data[j]);
+				i++;
+				if (j == 0) {
+					break;
+				}
+				j--;
+			}
+		}
+
+		if (k <= j) {
+			right = j;
+		} else if (k >= i) {
+			left = i;
+		} else {
+			break;
+		}
+	}
+
+	return data[k];
+}
+
+int16_t block_filter_median(int16_t *data, size_t count)
+{
+	int16_t upper = select_kth(data, count, count / 2);
+	int16_t lower = upper;
+
+	if (count % 2 == 0) {
+		/* The lower middle sample is the largest of the lower half. */
+		lower = data[0];
+		for (size_t i = 1; i < count / 2; i++) {
+			lower = MAX(lower, data[i]);
+		}
+	}
+
+	return ((int32_t)lower + upper) / 2;
+}
+
+#if defined(CONFIG_EXTERNAL_SENSORS_BLOCK_FILTER_BENCHMARK)
+#include <zephyr/logging/log.h>
+
+#include "benchmark.h"
+
+LOG_MODULE_REGISTER(block_filter, CONFIG_EXTERNAL_SENSORS_LOG_LEVEL);
+
+#define BENCHMARK_BLOCK	 CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_DECIMATION
+#define BENCHMARK_ROUNDS 100
+
+/* Run both variants on the same random blocks, check that they agree and log their time. */
+static void block_filter_benchmark(void)
+{
+	static int16_t block[BENCHMARK_BLOCK];
+	uint32_t rng = XORSHIFT32_SEED;
+	uint64_t scalar_cycles = 0;
+	uint64_t dsp_cycles = 0;
+	uint32_t mismatches = 0;
+
+	for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+		struct block_sums scalar, dsp;
+
+		/* Full scale samples in every other round to exercise the accumulators. */
+		for (size_t i = 0; i < ARRAY_SIZE(block); i++) {
+			block[i] = (round % 2) ? (int16_t)xorshift32(&rng)
+					       : (int16_t)(xorshift32(&rng) % 2001) - 1000;
+		}
+
+		BENCHMARK_TIME(scalar_cycles, block_sums_scalar(block, ARRAY_SIZE(block), &scalar));
+		BENCHMARK_TIME(dsp_cycles, block_sums_dsp(block, ARRAY_SIZE(block), &dsp));
+
+		mismatches += (scalar.sum != dsp.sum || scalar.sum_squares != dsp.sum_squares);
+	}
+
+	LOG_INF("Block of %d samples: scalar %llu cycles, DSP %llu cycles, %u mismatches",
+		BENCHMARK_BLOCK, scalar_cycles / BENCHMARK_ROUNDS, dsp_cycles / BENCHMARK_ROUNDS,
+		mismatches);
+}
+
+BENCHMARK_DEFINE(block_filter_benchmark);
+#endif /* defined(CONFIG_EXTERNAL_SENSORS_BLOCK_FILTER_BENCHMARK) */
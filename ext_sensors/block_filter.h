@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Filtering kernels for blocks of raw accelerometer samples of one axis.
+ */
+
+#ifndef BLOCK_FILTER_H__
+#define BLOCK_FILTER_H__
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Mean of a block.
+ *
+ * @param[in] data Samples.
+ * @param[in] count Number of samples, at least 1.
+ *
+ * @return The mean, rounded toward zero.
+ */
+int16_t block_filter_mean(const int16_t *data, size_t count);
+
+/**
+ * @brief Population variance of a block.
+ *
+ * @param[in] data Samples.
+ * @param[in] count Number of samples, at least 1.
+ *
+ * @return The variance in squared counts, rounded down.
+ */
+uint32_t block_filter_variance(const int16_t *data, size_t count);
+
+/**
+ * @brief Median of a block.
+ *
+ * @param[in,out] data Samples, reordered.
+ * @param[in] count Number of samples, at least 1.
+ *
+ * @return The median. For an even count, the mean of the two middle samples.
+ */
+int16_t block_filter_median(int16_t *data, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLOCK_FILTER_H__ */
@@ -8,6 +8,9 @@
 #include <stdio.h>
 #include <string.h>
 #include <zephyr/drivers/sensor.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/ring_buffer.h>
 #include <stdlib.h>
 #include <math.h>
 
@@ -16,6 +19,8 @@
 #endif
 
 #include "ext_sensors.h"
+#include "block_filter.h"
+#include "isqrt.h"
 
 #include <zephyr/logging/log.h>
 #include <zephyr/device.h>
@@ -49,6 +54,52 @@ LOG_MODULE_REGISTER(ext_sensors, CONFIG_EXTERNAL_SENSORS_LOG_LEVEL);
 
 #define ADXL362_TIMEOUT_RESOLUTION_MAX 65536
 
+/* ADXL362 registers and commands used to drive the FIFO. The sensor driver does not
+ * expose the FIFO, so it is accessed directly on the same SPI bus.
+ */
+#define ADXL362_CMD_WRITE_REG		 0x0A
+#define ADXL362_CMD_READ_REG		 0x0B
+#define ADXL362_CMD_READ_FIFO		 0x0D
+#define ADXL362_REG_FIFO_ENTRIES_L	 0x0C
+#define ADXL362_REG_FIFO_CONTROL	 0x28
+#define ADXL362_REG_FIFO_SAMPLES	 0x29
+#define ADXL362_REG_INTMAP1		 0x2A
+#define ADXL362_FIFO_CONTROL_AH		 BIT(3)
+#define ADXL362_FIFO_MODE_DISABLED	 0x00
+#define ADXL362_FIFO_MODE_STREAM	 0x02
+#define ADXL362_INTMAP1_DATA_READY	 BIT(0)
+#define ADXL362_INTMAP1_FIFO_WATERMARK	 BIT(2)
+#define ADXL362_FIFO_ENTRIES_MAX	 512
+#define ADXL362_FIFO_ENTRIES_MASK	 0x3FF
+#define ADXL362_FIFO_ENTRY_AXIS(entry)	 (((entry) >> 14) & 0x3)
+/* FIFO entries hold 14-bit two's complement data, sign extended into bits 13:12. */
+#define ADXL362_FIFO_ENTRY_VALUE(entry) ((int16_t)((entry) << 2) >> 2)
+
+#if defined(CONFIG_EXTERNAL_SENSORS_IMPACT_DETECTION)
+/* ADXL372 registers used to drain the peak FIFO directly on the SPI bus. */
+#define ADXL372_SPI_READ(reg)		 (((reg) << 1) | 1)
+#define ADXL372_SPI_WRITE(reg)		 ((reg) << 1)
+#define ADXL372_REG_FIFO_ENTRIES_2	 0x06
+#define ADXL372_REG_FIFO_SAMPLES	 0x39
+#define ADXL372_REG_FIFO_CTL		 0x3A
+#define ADXL372_REG_POWER_CTL		 0x3F
+#define ADXL372_REG_FIFO_DATA		 0x42
+#define ADXL372_FIFO_CTL_SAMPLES_MSB	 BIT(0)
+#define ADXL372_FIFO_CTL_MODE_STREAM	 (0x1 << 1)
+#define ADXL372_FIFO_CTL_FORMAT_XYZ_PEAK (0x7 << 3)
+#define ADXL372_POWER_CTL_MODE_MASK	 0x3
+#define ADXL372_FIFO_ENTRIES_MAX	 512
+#define ADXL372_FIFO_ENTRIES_MASK	 0x3FF
+/* FIFO entries hold 12-bit left justified data, bit 0 flags the first axis of a set. */
+#define ADXL372_FIFO_ENTRY_SERIES_START	 BIT(0)
+#define ADXL372_FIFO_ENTRY_VALUE(entry)	 ((int16_t)(entry) >> 4)
+#define ADXL372_MG_PER_LSB		 100
+
+/* Impacts below the threshold are compared in squared raw counts, which needs no sqrt. */
+#define IMPACT_THRESHOLD_LSB (CONFIG_EXTERNAL_SENSORS_IMPACT_THRESHOLD_MG / ADXL372_MG_PER_LSB)
+#define IMPACT_THRESHOLD_SQUARED ((uint32_t)IMPACT_THRESHOLD_LSB * IMPACT_THRESHOLD_LSB)
+#endif
+
 /* Local accelerometer threshold value. Used to filter out unwanted values in
  * the callback from the accelerometer.
  */
@@ -104,10 +155,80 @@ static struct env_sensor accel_sensor_hg = {
 	.channel = SENSOR_CHAN_ACCEL_XYZ,
 	.dev = DEVICE_DT_GET(DT_ALIAS(impact_sensor)),
 };
+
+static const struct spi_dt_spec accel_hg_spi =
+	SPI_DT_SPEC_GET(DT_ALIAS(impact_sensor), SPI_WORD_SET(8) | SPI_TRANSFER_MSB, 0);
+
+static uint8_t impact_fifo_buf[ADXL372_FIFO_ENTRIES_MAX * sizeof(uint16_t)];
+
+static void impact_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(impact_work, impact_work_fn);
+
+/* Impact whose refractory window is open, shared between the trigger and the work item. */
+static struct k_spinlock impact_lock;
+static bool impact_open;
+static int64_t impact_timestamp;
+static uint16_t impact_interrupts;
+#endif
+
+#if defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM)
+#if defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_ADAPTIVE)
+/* Block variance above which the device is moving, in squared raw counts. */
+#define ACCEL_STREAM_MOTION_VARIANCE                                                               \
+	((CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_MOTION_THRESHOLD_MG /                               \
+	  EXT_SENSORS_ACCEL_RAW_MG_PER_LSB) *                                                      \
+	 (CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_MOTION_THRESHOLD_MG /                               \
+	  EXT_SENSORS_ACCEL_RAW_MG_PER_LSB))
+#endif
+
+static const struct spi_dt_spec accel_lp_spi =
+	SPI_DT_SPEC_GET(DT_ALIAS(accelerometer), SPI_WORD_SET(8) | SPI_TRANSFER_MSB, 0);
+
+/* The driver dispatches the interrupt line for us. The data ready trigger is used as a
+ * carrier and rerouted to the FIFO watermark once it has been set.
+ */
+static struct sensor_trigger adxl362_sensor_trigger_fifo = {.chan = SENSOR_CHAN_ACCEL_XYZ,
+							    .type = SENSOR_TRIG_DATA_READY};
+
+RING_BUF_DECLARE(accel_stream_buf, CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_BUFFER_SIZE *
+					   sizeof(struct ext_sensor_accel_raw));
+static K_SEM_DEFINE(accel_stream_sem, 0, CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_BUFFER_SIZE);
+
+static uint8_t accel_fifo_buf[ADXL362_FIFO_ENTRIES_MAX * sizeof(uint16_t)];
+
+/* Partially received XYZ sample and the block of samples decimated into one, per axis. */
+static int16_t accel_stream_xyz[ACCELEROMETER_CHANNELS];
+static uint8_t accel_stream_axes;
+static int16_t accel_stream_block[ACCELEROMETER_CHANNELS]
+				 [CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_DECIMATION];
+static size_t accel_stream_block_count;
+
+/* Samples per block at the current rate. */
+static size_t accel_stream_decimation = CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_DECIMATION;
+#if defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_ADAPTIVE)
+/* Streaming at the fast rate, and the number of blocks since motion was last seen. */
+static bool accel_stream_fast;
+static uint8_t accel_stream_quiet_blocks;
+#endif
 #endif
 
 static ext_sensor_handler_t evt_handler;
 
+#if defined(CONFIG_EXTERNAL_SENSORS_EVT_FIXED_POINT)
+/* Acceleration in m/s2 to milli-g, in integer arithmetic. */
+static ext_sensor_value_t accel_value_get(const struct sensor_value *ms2)
+{
+	int64_t micro_ms2 = (int64_t)ms2->val1 * 1000000 + ms2->val2;
+
+	return micro_ms2 * 1000 / SENSOR_G;
+}
+#else
+static ext_sensor_value_t accel_value_get(const struct sensor_value *ms2)
+{
+	return sensor_value_to_double(ms2);
+}
+#endif
+
 static void accelerometer_trigger_handler(const struct device *dev,
 					  const struct sensor_trigger *trig)
 {
@@ -130,9 +251,9 @@ static void accelerometer_trigger_handler(const struct device *dev,
 			return;
 		}
 
-		evt.value_array[0] = sensor_value_to_double(&data[0]);
-		evt.value_array[1] = sensor_value_to_double(&data[1]);
-		evt.value_array[2] = sensor_value_to_double(&data[2]);
+		for (size_t i = 0; i < ACCELEROMETER_CHANNELS; i++) {
+			evt.value_array[i] = accel_value_get(&data[i]);
+		}
 
 		if (trig->type == SENSOR_TRIG_MOTION) {
 			evt.type = EXT_SENSOR_EVT_ACCELEROMETER_ACT_TRIGGER;
@@ -149,36 +270,371 @@ static void accelerometer_trigger_handler(const struct device *dev,
 	}
 }
 
+#if defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM)
+static int accel_lp_reg_write(uint8_t reg, uint8_t value)
+{
+	uint8_t cmd[] = {ADXL362_CMD_WRITE_REG, reg, value};
+	const struct spi_buf tx_buf = {.buf = cmd, .len = sizeof(cmd)};
+	const struct spi_buf_set tx = {.buffers = &tx_buf, .count = 1};
+
+	return spi_write_dt(&accel_lp_spi, &tx);
+}
+
+static int accel_lp_read(uint8_t *cmd, size_t cmd_len, void *data, size_t len)
+{
+	const struct spi_buf tx_buf = {.buf = cmd, .len = cmd_len};
+	const struct spi_buf_set tx = {.buffers = &tx_buf, .count = 1};
+	struct spi_buf rx_buf[] = {{.buf = NULL, .len = cmd_len}, {.buf = data, .len = len}};
+	const struct spi_buf_set rx = {.buffers = rx_buf, .count = ARRAY_SIZE(rx_buf)};
+
+	return spi_transceive_dt(&accel_lp_spi, &tx, &rx);
+}
+
+static int accel_lp_reg_read(uint8_t reg, void *data, size_t len)
+{
+	uint8_t cmd[] = {ADXL362_CMD_READ_REG, reg};
+
+	return accel_lp_read(cmd, sizeof(cmd), data, len);
+}
+
+static int accel_stream_watermark_set(uint16_t samples)
+{
+	uint16_t entries = samples * ACCELEROMETER_CHANNELS;
+	uint8_t fifo_control = ADXL362_FIFO_MODE_STREAM;
+	int err;
+
+	/* The ninth bit of the watermark is stored in the FIFO control register. */
+	if (entries > UINT8_MAX) {
+		fifo_control |= ADXL362_FIFO_CONTROL_AH;
+	}
+
+	err = accel_lp_reg_write(ADXL362_REG_FIFO_SAMPLES, entries & 0xFF);
+	if (err) {
+		return err;
+	}
+
+	return accel_lp_reg_write(ADXL362_REG_FIFO_CONTROL, fifo_control);
+}
+
+static int accel_stream_rate_set(bool fast)
+{
+#if defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_ADAPTIVE)
+	accel_stream_fast = fast;
+	accel_stream_quiet_blocks = 0;
+
+	if (fast) {
+		accel_stream_decimation = CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_FAST_DECIMATION;
+		return accel_stream_watermark_set(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_FAST_WATERMARK);
+	}
+#endif
+	accel_stream_decimation = CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_DECIMATION;
+	return accel_stream_watermark_set(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_WATERMARK);
+}
+
+#if defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_ADAPTIVE)
+/* Switch to the fast rate as soon as a block shows motion, and back to the slow rate once
+ * the signal has stayed quiet for a while.
+ */
+static void accel_stream_rate_update(void)
+{
+	uint32_t variance = 0;
+	int err = 0;
+
+	for (size_t i = 0; i < ACCELEROMETER_CHANNELS; i++) {
+		variance = MAX(variance, block_filter_variance(accel_stream_block[i],
+							       accel_stream_block_count));
+	}
+
+	if (variance > ACCEL_STREAM_MOTION_VARIANCE) {
+		accel_stream_quiet_blocks = 0;
+		if (!accel_stream_fast) {
+			err = accel_stream_rate_set(true);
+		}
+	} else if (accel_stream_fast &&
+		   ++accel_stream_quiet_blocks >= CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_MOTION_HOLD) {
+		err = accel_stream_rate_set(false);
+	}
+
+	if (err) {
+		LOG_WRN("Failed to change the stream rate, error: %d", err);
+	}
+}
+#endif
+
+static int16_t accel_stream_decimate(int16_t *block, size_t count)
+{
+#if defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_DECIMATION_MEDIAN)
+	return block_filter_median(block, count);
+#else
+	return block_filter_mean(block, count);
+#endif
+}
+
+static void accel_stream_push(const int16_t xyz[ACCELEROMETER_CHANNELS])
+{
+	struct ext_sensor_accel_raw sample;
+
+	for (size_t i = 0; i < ACCELEROMETER_CHANNELS; i++) {
+		accel_stream_block[i][accel_stream_block_count] = xyz[i];
+	}
+
+	if (++accel_stream_block_count < accel_stream_decimation) {
+		return;
+	}
+
+#if defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_ADAPTIVE)
+	/* Before decimation, the median reorders the block. */
+	accel_stream_rate_update();
+#endif
+
+	sample.x = accel_stream_decimate(accel_stream_block[0], accel_stream_block_count);
+	sample.y = accel_stream_decimate(accel_stream_block[1], accel_stream_block_count);
+	sample.z = accel_stream_decimate(accel_stream_block[2], accel_stream_block_count);
+
+	accel_stream_block_count = 0;
+
+	if (ring_buf_space_get(&accel_stream_buf) < sizeof(sample)) {
+		LOG_WRN("Accelerometer stream full, sample dropped");
+		return;
+	}
+
+	ring_buf_put(&accel_stream_buf, (uint8_t *)&sample, sizeof(sample));
+	k_sem_give(&accel_stream_sem);
+}
+
+static void accel_stream_reset(void)
+{
+	ring_buf_reset(&accel_stream_buf);
+	k_sem_reset(&accel_stream_sem);
+	accel_stream_block_count = 0;
+	accel_stream_axes = 0;
+}
+
+static void accelerometer_fifo_handler(const struct device *dev,
+				       const struct sensor_trigger *trig)
+{
+	uint8_t fifo_cmd = ADXL362_CMD_READ_FIFO;
+	uint16_t entries;
+	int err;
+
+	err = accel_lp_reg_read(ADXL362_REG_FIFO_ENTRIES_L, &entries, sizeof(entries));
+	if (err) {
+		LOG_ERR("Failed to read FIFO entries, error: %d", err);
+		return;
+	}
+
+	entries = MIN(sys_le16_to_cpu(entries) & ADXL362_FIFO_ENTRIES_MASK,
+		      ADXL362_FIFO_ENTRIES_MAX);
+	if (entries == 0) {
+		return;
+	}
+
+	/* Drain everything in one burst so that the watermark line is released. */
+	err = accel_lp_read(&fifo_cmd, sizeof(fifo_cmd), accel_fifo_buf,
+			    entries * sizeof(uint16_t));
+	if (err) {
+		LOG_ERR("Failed to read FIFO, error: %d", err);
+		return;
+	}
+
+	for (size_t i = 0; i < entries; i++) {
+		uint16_t entry = sys_get_le16(&accel_fifo_buf[i * sizeof(uint16_t)]);
+		uint8_t axis = ADXL362_FIFO_ENTRY_AXIS(entry);
+
+		/* Skip temperature entries. */
+		if (axis >= ACCELEROMETER_CHANNELS) {
+			continue;
+		}
+
+		/* Every sample starts with X, which also realigns the stream after an overrun. */
+		if (axis == 0) {
+			accel_stream_axes = 0;
+		}
+
+		accel_stream_xyz[axis] = ADXL362_FIFO_ENTRY_VALUE(entry);
+		accel_stream_axes |= BIT(axis);
+
+		if (accel_stream_axes == BIT_MASK(ACCELEROMETER_CHANNELS)) {
+			accel_stream_axes = 0;
+			accel_stream_push(accel_stream_xyz);
+		}
+	}
+}
+#endif /* defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM) */
+
 #if defined(CONFIG_EXTERNAL_SENSORS_IMPACT_DETECTION)
-static void impact_trigger_handler(const struct device *dev, const struct sensor_trigger *trig)
+static int accel_hg_reg_write(uint8_t reg, uint8_t value)
 {
-	struct sensor_value data[ACCELEROMETER_CHANNELS];
-	struct ext_sensor_evt evt = {0};
+	uint8_t cmd[] = {ADXL372_SPI_WRITE(reg), value};
+	const struct spi_buf tx_buf = {.buf = cmd, .len = sizeof(cmd)};
+	const struct spi_buf_set tx = {.buffers = &tx_buf, .count = 1};
+
+	return spi_write_dt(&accel_hg_spi, &tx);
+}
+
+static int accel_hg_reg_read(uint8_t reg, void *data, size_t len)
+{
+	uint8_t cmd = ADXL372_SPI_READ(reg);
+	const struct spi_buf tx_buf = {.buf = &cmd, .len = sizeof(cmd)};
+	const struct spi_buf_set tx = {.buffers = &tx_buf, .count = 1};
+	struct spi_buf rx_buf[] = {{.buf = NULL, .len = sizeof(cmd)}, {.buf = data, .len = len}};
+	const struct spi_buf_set rx = {.buffers = rx_buf, .count = ARRAY_SIZE(rx_buf)};
+
+	return spi_transceive_dt(&accel_hg_spi, &tx, &rx);
+}
+
+/* Store the peak of every over-threshold event in the FIFO, which is only configurable in
+ * standby.
+ */
+static int impact_fifo_configure(void)
+{
+	/* The watermark is not mapped to an interrupt, it only has to hold whole sets. */
+	uint16_t entries = ADXL372_FIFO_ENTRIES_MAX / ACCELEROMETER_CHANNELS * ACCELEROMETER_CHANNELS;
+	uint8_t fifo_ctl = ADXL372_FIFO_CTL_MODE_STREAM | ADXL372_FIFO_CTL_FORMAT_XYZ_PEAK;
+	uint8_t power_ctl;
+	int err, restore_err;
+
+	if (entries > UINT8_MAX) {
+		fifo_ctl |= ADXL372_FIFO_CTL_SAMPLES_MSB;
+	}
+
+	err = accel_hg_reg_read(ADXL372_REG_POWER_CTL, &power_ctl, sizeof(power_ctl));
+	if (err) {
+		return err;
+	}
+
+	err = accel_hg_reg_write(ADXL372_REG_POWER_CTL, power_ctl & ~ADXL372_POWER_CTL_MODE_MASK);
+	if (err) {
+		return err;
+	}
+
+	err = accel_hg_reg_write(ADXL372_REG_FIFO_SAMPLES, entries & 0xFF);
+	if (!err) {
+		err = accel_hg_reg_write(ADXL372_REG_FIFO_CTL, fifo_ctl);
+	}
+
+	/* Restore the measurement mode even if the FIFO could not be configured. */
+	restore_err = accel_hg_reg_write(ADXL372_REG_POWER_CTL, power_ctl);
+
+	return err ? err : restore_err;
+}
+
+/* Squared magnitude of a raw sample. Branch free and exact: 12-bit axes cannot overflow
+ * the sum.
+ */
+static inline uint32_t impact_magnitude_squared(const int16_t xyz[ACCELEROMETER_CHANNELS])
+{
+	return (int32_t)xyz[0] * xyz[0] + (int32_t)xyz[1] * xyz[1] + (int32_t)xyz[2] * xyz[2];
+}
+
+/* Drain the FIFO and return the largest squared peak magnitude in it, in squared raw
+ * counts, or 0 if it held no complete peak.
+ */
+static uint32_t impact_fifo_peak(void)
+{
+	int16_t xyz[ACCELEROMETER_CHANNELS];
+	uint32_t peak = 0;
+	uint8_t axes = ACCELEROMETER_CHANNELS;
+	uint8_t count[2];
+	uint16_t entries;
 	int err;
 
-	switch (trig->type) {
-	case SENSOR_TRIG_THRESHOLD:
-		if (sensor_sample_fetch(dev) < 0) {
-			LOG_ERR("Sample fetch error");
-			return;
+	err = accel_hg_reg_read(ADXL372_REG_FIFO_ENTRIES_2, count, sizeof(count));
+	if (err) {
+		LOG_ERR("Failed to read FIFO entries, error: %d", err);
+		return 0;
+	}
+
+	entries = MIN(sys_get_be16(count) & ADXL372_FIFO_ENTRIES_MASK, ADXL372_FIFO_ENTRIES_MAX);
+	if (entries == 0) {
+		return 0;
+	}
+
+	err = accel_hg_reg_read(ADXL372_REG_FIFO_DATA, impact_fifo_buf, entries * sizeof(uint16_t));
+	if (err) {
+		LOG_ERR("Failed to read FIFO, error: %d", err);
+		return 0;
+	}
+
+	for (size_t i = 0; i < entries; i++) {
+		uint16_t entry = sys_get_be16(&impact_fifo_buf[i * sizeof(uint16_t)]);
+
+		/* Entries before the first series start belong to a set that was overwritten. */
+		if (entry & ADXL372_FIFO_ENTRY_SERIES_START) {
+			axes = 0;
+		} else if (axes >= ACCELEROMETER_CHANNELS) {
+			continue;
 		}
 
-		err = sensor_channel_get(dev, SENSOR_CHAN_ACCEL_XYZ, data);
-		if (err) {
-			LOG_ERR("sensor_channel_get, error: %d", err);
-			return;
+		xyz[axes++] = ADXL372_FIFO_ENTRY_VALUE(entry);
+
+		if (axes == ACCELEROMETER_CHANNELS) {
+			peak = MAX(peak, impact_magnitude_squared(xyz));
 		}
+	}
+
+	return peak;
+}
+
+#if defined(CONFIG_EXTERNAL_SENSORS_EVT_FIXED_POINT)
+static ext_sensor_value_t impact_value_get(uint32_t peak)
+{
+	return isqrt((uint64_t)peak * ADXL372_MG_PER_LSB * ADXL372_MG_PER_LSB);
+}
+#else
+static ext_sensor_value_t impact_value_get(uint32_t peak)
+{
+	return sqrt(peak) * ADXL372_MG_PER_LSB / 1000.0;
+}
+#endif
+
+/* Runs once the refractory window of an impact has passed. Every peak collected in the
+ * window belongs to the same impact, so a single event carries the largest of them.
+ */
+static void impact_work_fn(struct k_work *work)
+{
+	struct ext_sensor_evt evt = {0};
+	uint32_t peak = impact_fifo_peak();
+	k_spinlock_key_t key = k_spin_lock(&impact_lock);
+
+	evt.timestamp = impact_timestamp;
+	LOG_DBG("Impact spanning %d interrupts", impact_interrupts);
+	impact_open = false;
+	k_spin_unlock(&impact_lock, key);
+
+	if (peak < IMPACT_THRESHOLD_SQUARED) {
+		LOG_DBG("Impact below the threshold ignored");
+		return;
+	}
+
+	evt.value = impact_value_get(peak);
 
-		evt.value = sqrt(pow(sensor_ms2_to_g(&data[0]), 2.0) +
-				 pow(sensor_ms2_to_g(&data[1]), 2.0) +
-				 pow(sensor_ms2_to_g(&data[2]), 2.0));
+	LOG_DBG("Detected impact of %d mg", EXT_SENSOR_EVT_IMPACT_MG(&evt));
 
-		LOG_DBG("Detected impact of %6.2f g\n", evt.value);
+	evt.type = EXT_SENSOR_EVT_ACCELEROMETER_IMPACT_TRIGGER;
+	evt_handler(&evt);
+}
+
+static void impact_trigger_handler(const struct device *dev, const struct sensor_trigger *trig)
+{
+	k_spinlock_key_t key;
 
-		if (evt.value > 0.0) {
-			evt.type = EXT_SENSOR_EVT_ACCELEROMETER_IMPACT_TRIGGER;
-			evt_handler(&evt);
+	switch (trig->type) {
+	case SENSOR_TRIG_THRESHOLD:
+		/* A single impact rings for a while and raises several interrupts, only the
+		 * first one opens an impact. The handler runs in the driver thread, which
+		 * preempts the work queue, so this is close to the time of the interrupt.
+		 */
+		key = k_spin_lock(&impact_lock);
+		if (!impact_open) {
+			impact_open = true;
+			impact_timestamp = k_uptime_get();
+			impact_interrupts = 0;
+			k_work_schedule(&impact_work,
+					K_MSEC(CONFIG_EXTERNAL_SENSORS_IMPACT_REFRACTORY_MS));
 		}
+		impact_interrupts++;
+		k_spin_unlock(&impact_lock, key);
 		break;
 	default:
 		LOG_ERR("Unknown trigger");
@@ -186,6 +642,86 @@ static void impact_trigger_handler(const struct device *dev, const struct sensor
 }
 #endif
 
+#if defined(CONFIG_EXTERNAL_SENSORS_IMPACT_BENCHMARK)
+#include "benchmark.h"
+
+#define BENCHMARK_ROUNDS 1000
+
+/* Thresholds in raw counts of 100 mg. The smallest ones are right at the quantisation
+ * step, where rounding differences between the two decisions would show.
+ */
+static const uint16_t benchmark_thresholds[] = {1, 2, 3, 5, 10, 50, 100, 500, 1000, 2000};
+
+/* The threshold decision as it was made on every interrupt: the sample converted to
+ * m/s2 the way the driver does, then to g, and its magnitude in double precision.
+ */
+static bool impact_above_threshold_double(const int16_t xyz[ACCELEROMETER_CHANNELS],
+					  uint32_t threshold_lsb)
+{
+	struct sensor_value data[ACCELEROMETER_CHANNELS];
+
+	for (size_t i = 0; i < ACCELEROMETER_CHANNELS; i++) {
+		int64_t micro_ms2 = (int64_t)xyz[i] * ADXL372_MG_PER_LSB * SENSOR_G / 1000;
+
+		data[i].val1 = micro_ms2 / 1000000;
+		data[i].val2 = micro_ms2 % 1000000;
+	}
+
+	return sqrt(pow(sensor_ms2_to_g(&data[0]), 2.0) + pow(sensor_ms2_to_g(&data[1]), 2.0) +
+		    pow(sensor_ms2_to_g(&data[2]), 2.0)) >=
+	       threshold_lsb * ADXL372_MG_PER_LSB / 1000.0;
+}
+
+/* Make the threshold decision on the same random samples both ways for each threshold,
+ * check that they agree and log the cycles each takes per sample. Every other sample is
+ * within a count of the threshold, where the decisions can differ.
+ */
+static void impact_benchmark(void)
+{
+	uint32_t rng = XORSHIFT32_SEED;
+
+	for (size_t t = 0; t < ARRAY_SIZE(benchmark_thresholds); t++) {
+		uint32_t threshold = benchmark_thresholds[t];
+		uint32_t threshold_squared = threshold * threshold;
+		int16_t xyz[ACCELEROMETER_CHANNELS];
+		uint64_t double_cycles = 0;
+		uint64_t squared_cycles = 0;
+		uint32_t mismatches = 0;
+
+		for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+			bool above_double, above_squared;
+
+			if (round % 2) {
+				/* 12-bit samples, as read from the FIFO. */
+				for (size_t i = 0; i < ARRAY_SIZE(xyz); i++) {
+					xyz[i] = (int16_t)(xorshift32(&rng) % 4096) - 2048;
+				}
+			} else {
+				/* On an axis, one count below, at or above the threshold. */
+				memset(xyz, 0, sizeof(xyz));
+				xyz[(round / 2) % ARRAY_SIZE(xyz)] =
+					threshold + (int16_t)(xorshift32(&rng) % 3) - 1;
+			}
+
+			BENCHMARK_TIME(double_cycles,
+				       above_double = impact_above_threshold_double(xyz, threshold));
+			BENCHMARK_TIME(squared_cycles,
+				       above_squared = impact_magnitude_squared(xyz) >=
+						       threshold_squared);
+
+			mismatches += (above_double != above_squared);
+		}
+
+		LOG_INF("Impact threshold %u mg per sample: double %llu cycles, squared %llu "
+			"cycles, %u mismatches",
+			threshold * ADXL372_MG_PER_LSB, double_cycles / BENCHMARK_ROUNDS,
+			squared_cycles / BENCHMARK_ROUNDS, mismatches);
+	}
+}
+
+BENCHMARK_DEFINE(impact_benchmark);
+#endif /* defined(CONFIG_EXTERNAL_SENSORS_IMPACT_BENCHMARK) */
+
 int ext_sensors_init(ext_sensor_handler_t handler)
 {
 	struct ext_sensor_evt evt = {0};
@@ -235,8 +771,16 @@ int ext_sensors_init(ext_sensor_handler_t handler)
 		evt.type = EXT_SENSOR_EVT_ACCELEROMETER_ERROR;
 		evt_handler(&evt);
 	} else {
-		int err = sensor_trigger_set(accel_sensor_hg.dev, &adxl372_sensor_trigger,
-					     impact_trigger_handler);
+		int err = impact_fifo_configure();
+
+		if (err) {
+			LOG_ERR("Could not configure the FIFO of %s, error: %d",
+				accel_sensor_hg.dev->name, err);
+			return err;
+		}
+
+		err = sensor_trigger_set(accel_sensor_hg.dev, &adxl372_sensor_trigger,
+					 impact_trigger_handler);
 		if (err) {
 			LOG_ERR("Could not set trigger for device %s, error: %d",
 				accel_sensor_hg.dev->name, err);
@@ -462,3 +1006,110 @@ error:
 	evt_handler(&evt);
 	return err;
 }
+
+int ext_sensors_accelerometer_stream_start(void)
+{
+#if defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM)
+	int err;
+	uint8_t intmap;
+	struct ext_sensor_evt evt = {0};
+
+	if (!spi_is_ready_dt(&accel_lp_spi)) {
+		LOG_ERR("Low-power accelerometer SPI bus is not ready");
+		return -ENODEV;
+	}
+
+	accel_stream_reset();
+
+	err = sensor_trigger_set(accel_sensor_lp.dev, &adxl362_sensor_trigger_fifo,
+				 accelerometer_fifo_handler);
+	if (err) {
+		goto error;
+	}
+
+	/* The stream is started on activity, so it starts at the fast rate when adaptive. */
+	err = accel_stream_rate_set(IS_ENABLED(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_ADAPTIVE));
+	if (err) {
+		goto error;
+	}
+
+	err = accel_lp_reg_read(ADXL362_REG_INTMAP1, &intmap, sizeof(intmap));
+	if (err) {
+		goto error;
+	}
+
+	intmap &= ~ADXL362_INTMAP1_DATA_READY;
+	intmap |= ADXL362_INTMAP1_FIFO_WATERMARK;
+
+	err = accel_lp_reg_write(ADXL362_REG_INTMAP1, intmap);
+	if (err) {
+		goto error;
+	}
+
+	return 0;
+error:
+	LOG_ERR("Could not start stream for device %s, error: %d", accel_sensor_lp.dev->name, err);
+	evt.type = EXT_SENSOR_EVT_ACCELEROMETER_ERROR;
+	evt_handler(&evt);
+	return err;
+#else
+	return -ENOTSUP;
+#endif /* defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM) */
+}
+
+int ext_sensors_accelerometer_stream_stop(void)
+{
+#if defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM)
+	int err;
+	uint8_t intmap;
+	struct ext_sensor_evt evt = {0};
+
+	err = accel_lp_reg_read(ADXL362_REG_INTMAP1, &intmap, sizeof(intmap));
+	if (err) {
+		goto error;
+	}
+
+	err = accel_lp_reg_write(ADXL362_REG_INTMAP1, intmap & ~ADXL362_INTMAP1_FIFO_WATERMARK);
+	if (err) {
+		goto error;
+	}
+
+	err = accel_lp_reg_write(ADXL362_REG_FIFO_CONTROL, ADXL362_FIFO_MODE_DISABLED);
+	if (err) {
+		goto error;
+	}
+
+	err = sensor_trigger_set(accel_sensor_lp.dev, &adxl362_sensor_trigger_fifo, NULL);
+	if (err) {
+		goto error;
+	}
+
+	return 0;
+error:
+	LOG_ERR("Could not stop stream for device %s, error: %d", accel_sensor_lp.dev->name, err);
+	evt.type = EXT_SENSOR_EVT_ACCELEROMETER_ERROR;
+	evt_handler(&evt);
+	return err;
+#else
+	return -ENOTSUP;
+#endif /* defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM) */
+}
+
+int ext_sensors_accelerometer_stream_read(struct ext_sensor_accel_raw *sample,
+					  k_timeout_t timeout)
+{
+#if defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM)
+	if (k_sem_take(&accel_stream_sem, timeout)) {
+		return -EAGAIN;
+	}
+
+	if (ring_buf_get(&accel_stream_buf, (uint8_t *)sample, sizeof(*sample)) !=
+	    sizeof(*sample)) {
+		return -ENODATA;
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif /* defined(CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM) */
+}
@@ -18,6 +18,8 @@
  * @{
  */
 
+#include <zephyr/kernel.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -25,6 +27,15 @@ extern "C" {
 /** Number of accelerometer channels. */
 #define ACCELEROMETER_CHANNELS 3
 
+/** Resolution of raw low-power accelerometer samples in milli-g per LSB. */
+#if defined(CONFIG_ADXL362_ACCEL_RANGE_8G)
+#define EXT_SENSORS_ACCEL_RAW_MG_PER_LSB 4
+#elif defined(CONFIG_ADXL362_ACCEL_RANGE_4G)
+#define EXT_SENSORS_ACCEL_RAW_MG_PER_LSB 2
+#else
+#define EXT_SENSORS_ACCEL_RAW_MG_PER_LSB 1
+#endif
+
 /** @brief Enum containing callback events from library. */
 enum ext_sensor_evt_type {
 	/** Event that is sent if acceleration is detected */
@@ -46,6 +57,25 @@ enum ext_sensor_evt_type {
 	EXT_SENSOR_EVT_AIR_QUALITY_ERROR
 };
 
+/** @brief Value carried by an event.
+ *
+ *  With CONFIG_EXTERNAL_SENSORS_EVT_FIXED_POINT accelerations are integers in milli-g.
+ *  Otherwise they are doubles, in m/s2 for the low-power accelerometer and in g for
+ *  impacts.
+ */
+#if defined(CONFIG_EXTERNAL_SENSORS_EVT_FIXED_POINT)
+typedef int32_t ext_sensor_value_t;
+#else
+typedef double ext_sensor_value_t;
+#endif
+
+/** Magnitude of an impact event in milli-g, for either value layout. */
+#if defined(CONFIG_EXTERNAL_SENSORS_EVT_FIXED_POINT)
+#define EXT_SENSOR_EVT_IMPACT_MG(evt) ((evt)->value)
+#else
+#define EXT_SENSOR_EVT_IMPACT_MG(evt) ((int32_t)((evt)->value * 1000.0))
+#endif
+
 /** @brief Structure containing external sensor data. */
 struct ext_sensor_evt {
 	/** Sensor type. */
@@ -53,10 +83,19 @@ struct ext_sensor_evt {
 	/** Event data. */
 	union {
 		/** Array of external sensor values. */
-		double value_array[ACCELEROMETER_CHANNELS];
+		ext_sensor_value_t value_array[ACCELEROMETER_CHANNELS];
 		/** Single external sensor value. */
-		double value;
+		ext_sensor_value_t value;
 	};
+	/** Uptime in milliseconds at which an impact started. */
+	int64_t timestamp;
+};
+
+/** @brief Raw XYZ sample from the low-power accelerometer FIFO. */
+struct ext_sensor_accel_raw {
+	int16_t x;
+	int16_t y;
+	int16_t z;
 };
 
 /** @brief External sensors library asynchronous event handler.
@@ -150,6 +189,37 @@ int ext_sensors_inactivity_timeout_set(double inact_time);
  */
 int ext_sensors_accelerometer_trigger_callback_set(bool enable);
 
+/**
+ * @brief Start streaming raw samples from the low-power accelerometer.
+ *
+ * @details The hardware FIFO is drained on a watermark interrupt and the samples are
+ *	    decimated into a ring buffer that is read with
+ *	    ext_sensors_accelerometer_stream_read().
+ *
+ * @return 0 on success or negative error value on failure.
+ */
+int ext_sensors_accelerometer_stream_start(void);
+
+/**
+ * @brief Stop streaming raw samples from the low-power accelerometer.
+ *
+ * @return 0 on success or negative error value on failure.
+ */
+int ext_sensors_accelerometer_stream_stop(void);
+
+/**
+ * @brief Read the oldest sample from the accelerometer stream.
+ *
+ * @param[out] sample Pointer to variable containing the raw sample. One LSB equals
+ *		      EXT_SENSORS_ACCEL_RAW_MG_PER_LSB milli-g.
+ * @param[in] timeout Time to wait for a sample if the stream is empty.
+ *
+ * @return 0 on success or negative error value on failure.
+ * @retval -EAGAIN if no sample was available within the timeout.
+ */
+int ext_sensors_accelerometer_stream_read(struct ext_sensor_accel_raw *sample,
+					  k_timeout_t timeout);
+
 #ifdef __cplusplus
 }
 #endif
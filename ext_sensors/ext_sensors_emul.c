@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Emulated external sensors for qemu_x86 and native_sim. A scenario compiled into the
+ * image sets the gravity vector seen by the low-power accelerometer, injects impacts,
+ * environment readings and button presses at given times, and the library API is
+ * served from that state the way the sensors would serve it.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(CONFIG_GPIO_EMUL)
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#endif
+
+#include "ext_sensors.h"
+#include "xorshift.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ext_sensors, CONFIG_EXTERNAL_SENSORS_LOG_LEVEL);
+
+#define EMUL_THREAD_STACK_SIZE 1024
+#define EMUL_BUTTON_PRESS_MS   50
+
+enum emul_event_type {
+	/** Gravity vector in milli-g. */
+	EXT_SENSORS_EMUL_GRAVITY,
+	/** Impact, peak magnitude in milli-g. */
+	EXT_SENSORS_EMUL_IMPACT,
+	/** Temperature in milli-degrees Celsius, humidity in milli-percent, pressure in Pa. */
+	EXT_SENSORS_EMUL_ENV,
+	/** Press and release of the button. */
+	EXT_SENSORS_EMUL_BUTTON,
+};
+
+struct emul_event {
+	/** Time since the start of the scenario in milliseconds. */
+	uint32_t time;
+	enum emul_event_type type;
+	int32_t value[3];
+};
+
+/* Generated at build time from CONFIG_EXTERNAL_SENSORS_EMUL_SCENARIO. */
+#include "emul_scenario.inc"
+
+#if DT_NODE_EXISTS(DT_ALIAS(sw0)) && defined(CONFIG_GPIO_EMUL)
+static const struct gpio_dt_spec emul_button = GPIO_DT_SPEC_GET(DT_ALIAS(sw0), gpios);
+#endif
+
+static ext_sensor_handler_t evt_handler;
+
+/* Sensor state set by the scenario */
+static struct k_spinlock emul_lock;
+static int32_t emul_gravity[ACCELEROMETER_CHANNELS] = {0, 0, 1000};
+static int32_t emul_env[3] = {22000, 40000, 101325};
+
+/* Motion detection as configured through the library */
+static int32_t activity_threshold_mg = 1000;
+static uint32_t inactivity_timeout_ms = 1000;
+static bool triggers_enabled;
+static bool moving;
+
+static void inactivity_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(inactivity_work, inactivity_work_fn);
+
+RING_BUF_DECLARE(accel_stream_buf, CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_BUFFER_SIZE *
+					   sizeof(struct ext_sensor_accel_raw));
+static K_SEM_DEFINE(accel_stream_sem, 0, CONFIG_EXTERNAL_SENSORS_ACCEL_STREAM_BUFFER_SIZE);
+
+static void stream_timer_fn(struct k_timer *timer);
+static K_TIMER_DEFINE(stream_timer, stream_timer_fn, NULL);
+
+static K_THREAD_STACK_DEFINE(emul_stack, EMUL_THREAD_STACK_SIZE);
+static struct k_thread emul_thread;
+
+static int16_t emul_noise(void)
+{
+	int32_t span = 2 * CONFIG_EXTERNAL_SENSORS_EMUL_NOISE_MG + 1;
+
+	static uint32_t rng = XORSHIFT32_SEED;
+
+	return (int32_t)(xorshift32(&rng) % span) - CONFIG_EXTERNAL_SENSORS_EMUL_NOISE_MG;
+}
+
+static void stream_timer_fn(struct k_timer *timer)
+{
+	struct ext_sensor_accel_raw sample;
+	k_spinlock_key_t key = k_spin_lock(&emul_lock);
+
+	sample.x = (emul_gravity[0] + emul_noise()) / EXT_SENSORS_ACCEL_RAW_MG_PER_LSB;
+	sample.y = (emul_gravity[1] + emul_noise()) / EXT_SENSORS_ACCEL_RAW_MG_PER_LSB;
+	sample.z = (emul_gravity[2] + emul_noise()) / EXT_SENSORS_ACCEL_RAW_MG_PER_LSB;
+	k_spin_unlock(&emul_lock, key);
+
+	if (ring_buf_space_get(&accel_stream_buf) < sizeof(sample)) {
+		LOG_WRN("Accelerometer stream full, sample dropped");
+		return;
+	}
+
+	ring_buf_put(&accel_stream_buf, (uint8_t *)&sample, sizeof(sample));
+	k_sem_give(&accel_stream_sem);
+}
+
+static void motion_evt_send(enum ext_sensor_evt_type type)
+{
+	struct ext_sensor_evt evt = {.type = type};
+	k_spinlock_key_t key = k_spin_lock(&emul_lock);
+
+	for (size_t i = 0; i < ACCELEROMETER_CHANNELS; i++) {
+#if defined(CONFIG_EXTERNAL_SENSORS_EVT_FIXED_POINT)
+		evt.value_array[i] = emul_gravity[i];
+#else
+		evt.value_array[i] = emul_gravity[i] * (SENSOR_G / 1000000000.0);
+#endif
+	}
+	k_spin_unlock(&emul_lock, key);
+
+	evt_handler(&evt);
+}
+
+static void inactivity_work_fn(struct k_work *work)
+{
+	moving = false;
+
+	if (triggers_enabled) {
+		LOG_DBG("Inactivity detected");
+		motion_evt_send(EXT_SENSOR_EVT_ACCELEROMETER_INACT_TRIGGER);
+	}
+}
+
+/* Like the referenced mode of the ADXL362, any axis changing by more than the activity
+ * threshold is motion, and the device is still once no motion has been seen for the
+ * inactivity timeout.
+ */
+static void emul_gravity_set(const int32_t gravity[ACCELEROMETER_CHANNELS])
+{
+	int32_t change = 0;
+	k_spinlock_key_t key = k_spin_lock(&emul_lock);
+
+	for (size_t i = 0; i < ACCELEROMETER_CHANNELS; i++) {
+		change = MAX(change, abs(gravity[i] - emul_gravity[i]));
+		emul_gravity[i] = gravity[i];
+	}
+	k_spin_unlock(&emul_lock, key);
+
+	if (change <= activity_threshold_mg) {
+		return;
+	}
+
+	if (!moving && triggers_enabled) {
+		LOG_DBG("Activity detected");
+		motion_evt_send(EXT_SENSOR_EVT_ACCELEROMETER_ACT_TRIGGER);
+	}
+
+	moving = true;
+	k_work_reschedule(&inactivity_work, K_MSEC(inactivity_timeout_ms));
+}
+
+static void emul_impact(int32_t magnitude)
+{
+#if defined(CONFIG_EXTERNAL_SENSORS_IMPACT_DETECTION)
+	struct ext_sensor_evt evt = {
+		.type = EXT_SENSOR_EVT_ACCELEROMETER_IMPACT_TRIGGER,
+		.timestamp = k_uptime_get(),
+	};
+
+	if (magnitude < CONFIG_EXTERNAL_SENSORS_IMPACT_THRESHOLD_MG) {
+		return;
+	}
+
+#if defined(CONFIG_EXTERNAL_SENSORS_EVT_FIXED_POINT)
+	evt.value = magnitude;
+#else
+	evt.value = magnitude / 1000.0;
+#endif
+
+	evt_handler(&evt);
+#endif
+}
+
+static void emul_button_press(void)
+{
+#if DT_NODE_EXISTS(DT_ALIAS(sw0)) && defined(CONFIG_GPIO_EMUL)
+	gpio_emul_input_set(emul_button.port, emul_button.pin, 1);
+	k_sleep(K_MSEC(EMUL_BUTTON_PRESS_MS));
+	gpio_emul_input_set(emul_button.port, emul_button.pin, 0);
+#else
+	LOG_WRN("No emulated button, press ignored");
+#endif
+}
+
+static void emul_thread_fn(void *p1, void *p2, void *p3)
+{
+	do {
+		int64_t start = k_uptime_get();
+		uint32_t impacts = 0;
+		uint32_t moves = 0;
+
+		LOG_INF("Scenario started, %u events", (uint32_t)ARRAY_SIZE(emul_scenario));
+
+		for (size_t i = 0; i < ARRAY_SIZE(emul_scenario); i++) {
+			const struct emul_event *e = &emul_scenario[i];
+			k_spinlock_key_t key;
+
+			k_sleep(K_TIMEOUT_ABS_MS(start + e->time));
+
+			switch (e->type) {
+			case EXT_SENSORS_EMUL_GRAVITY:
+				emul_gravity_set(e->value);
+				moves++;
+				break;
+			case EXT_SENSORS_EMUL_IMPACT:
+				emul_impact(e->value[0]);
+				impacts++;
+				break;
+			case EXT_SENSORS_EMUL_ENV:
+				key = k_spin_lock(&emul_lock);
+				memcpy(emul_env, e->value, sizeof(emul_env));
+				k_spin_unlock(&emul_lock, key);
+				break;
+			case EXT_SENSORS_EMUL_BUTTON:
+				emul_button_press();
+				break;
+			}
+		}
+
+		LOG_INF("Scenario finished after %lld ms: %u gravity changes, %u impacts",
+			k_uptime_get() - start, moves, impacts);
+	} while (IS_ENABLED(CONFIG_EXTERNAL_SENSORS_EMUL_LOOP));
+}
+
+int ext_sensors_init(ext_sensor_handler_t handler)
+{
+	static bool started;
+
+	if (handler == NULL) {
+		LOG_ERR("External sensor handler NULL!");
+		return -EINVAL;
+	}
+
+	evt_handler = handler;
+
+	if (!started) {
+		started = true;
+		k_thread_create(&emul_thread, emul_stack, K_THREAD_STACK_SIZEOF(emul_stack),
+				emul_thread_fn, NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO,
+				0, K_NO_WAIT);
+		k_thread_name_set(&emul_thread, "ext_sensors_emul");
+	}
+
+	return 0;
+}
+
+static double emul_env_get(size_t i)
+{
+	k_spinlock_key_t key = k_spin_lock(&emul_lock);
+	int32_t value = emul_env[i];
+
+	k_spin_unlock(&emul_lock, key);
+
+	return value;
+}
+
+int ext_sensors_temperature_get(double *ext_temp)
+{
+	*ext_temp = emul_env_get(0) / 1000.0;
+	return 0;
+}
+
+int ext_sensors_humidity_get(double *ext_hum)
+{
+	*ext_hum = emul_env_get(1) / 1000.0;
+	return 0;
+}
+
+int ext_sensors_pressure_get(double *ext_press)
+{
+	/* kPa, as reported by the BME680 driver */
+	*ext_press = emul_env_get(2) / 1000.0;
+	return 0;
+}
+
+int ext_sensors_air_quality_get(uint16_t *ext_bsec_air_quality)
+{
+	return -ENOTSUP;
+}
+
+int ext_sensors_accelerometer_threshold_set(double threshold, bool upper)
+{
+	if (threshold <= 0.0) {
+		LOG_ERR("Invalid %s threshold value: %f", upper ? "activity" : "inactivity",
+			threshold);
+		return -ENOTSUP;
+	}
+
+	/* Inactivity is detected by the timeout alone. */
+	if (upper) {
+		activity_threshold_mg = threshold * 1000000000.0 / SENSOR_G;
+	}
+
+	return 0;
+}
+
+int ext_sensors_inactivity_timeout_set(double inact_time)
+{
+	if (inact_time < 0) {
+		LOG_ERR("Invalid timeout value");
+		return -ENOTSUP;
+	}
+
+	inactivity_timeout_ms = inact_time * 1000;
+	return 0;
+}
+
+int ext_sensors_accelerometer_trigger_callback_set(bool enable)
+{
+	triggers_enabled = enable;
+	return 0;
+}
+
+int ext_sensors_accelerometer_stream_start(void)
+{
+	ring_buf_reset(&accel_stream_buf);
+	k_sem_reset(&accel_stream_sem);
+	k_timer_start(&stream_timer, K_MSEC(CONFIG_EXTERNAL_SENSORS_EMUL_STREAM_PERIOD_MS),
+		      K_MSEC(CONFIG_EXTERNAL_SENSORS_EMUL_STREAM_PERIOD_MS));
+	return 0;
+}
+
+int ext_sensors_accelerometer_stream_stop(void)
+{
+	k_timer_stop(&stream_timer);
+	return 0;
+}
+
+int ext_sensors_accelerometer_stream_read(struct ext_sensor_accel_raw *sample,
+					  k_timeout_t timeout)
+{
+	if (k_sem_take(&accel_stream_sem, timeout)) {
+		return -EAGAIN;
+	}
+
+	if (ring_buf_get(&accel_stream_buf, (uint8_t *)sample, sizeof(*sample)) !=
+	    sizeof(*sample)) {
+		return -ENODATA;
+	}
+
+	return 0;
+}
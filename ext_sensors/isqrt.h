@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Integer square root for accelerometer magnitudes.
+ */
+
+#ifndef ISQRT_H__
+#define ISQRT_H__
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Bitwise integer square root, without floating point.
+ *
+ * @param[in] value Value, such as a squared magnitude.
+ *
+ * @return The square root, rounded down.
+ */
+static inline uint32_t isqrt(uint64_t value)
+{
+	uint64_t root = 0;
+	uint64_t bit;
+
+	if (value == 0) {
+		return 0;
+	}
+
+	/* Start at the highest even power of two not above the value. */
+	bit = 1ULL << ((63 - __builtin_clzll(value)) & ~1);
+
+	while (bit) {
+		if (value >= root + bit) {
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		} else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return root;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ISQRT_H__ */
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Small pseudo random generator for emulated sensor noise and benchmarks.
+ */
+
+#ifndef XORSHIFT_H__
+#define XORSHIFT_H__
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Seed of a generator, any nonzero value works. */
+#define XORSHIFT32_SEED 2463534242U
+
+/**
+ * @brief Next number of a xorshift32 generator. The sequence is the same on every run.
+ *
+ * @param[in,out] state Generator state, initialized to XORSHIFT32_SEED.
+ *
+ * @return Pseudo random number.
+ */
+static inline uint32_t xorshift32(uint32_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+	return *state;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XORSHIFT_H__ */
@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""Decode habit_data and habit_batch payloads published by the firmware.
+
+Both the current format, with millisecond timestamps and zigzag deltas, and the format
+of earlier firmware, with int32 timestamps in seconds, are read. Every event is printed
+as one JSON object with absolute times in milliseconds since the epoch:
+
+  {"habit_id": "...", "data": 3, "timestamp_ms": ..., "start_ms": ..., "stop_ms": ...}
+
+start_ms and stop_ms are only present for TIME habits. Events that refer to their habit by
+the handle assigned in the device shadow carry habit_handle instead of habit_id; with
+--shadow the handles are resolved to habit IDs from the side configs of a shadow document.
+"""
+
+import argparse
+import json
+import sys
+
+WIRE_VARINT = 0
+WIRE_FIXED64 = 1
+WIRE_LEN = 2
+WIRE_FIXED32 = 5
+
+
+def varint(buf, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(buf):
+            raise ValueError('truncated varint')
+        byte = buf[pos]
+        pos += 1
+        value |= (byte & 0x7f) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def zigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def int32(value):
+    value &= 0xffffffff
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def fields(buf):
+    """Yield (field number, wire type, value) for every field of a message."""
+    pos = 0
+    while pos < len(buf):
+        key, pos = varint(buf, pos)
+        number, wire = key >> 3, key & 7
+        if wire == WIRE_VARINT:
+            value, pos = varint(buf, pos)
+        elif wire == WIRE_LEN:
+            length, pos = varint(buf, pos)
+            value = buf[pos:pos + length]
+            if len(value) != length:
+                raise ValueError('truncated field')
+            pos += length
+        elif wire == WIRE_FIXED64:
+            value = int.from_bytes(buf[pos:pos + 8], 'little')
+            pos += 8
+        elif wire == WIRE_FIXED32:
+            value = int.from_bytes(buf[pos:pos + 4], 'little')
+            pos += 4
+        else:
+            raise ValueError(f'unsupported wire type {wire}')
+        yield number, wire, value
+
+
+def decode_event(buf, previous_ms=None):
+    """Decode one habit_data. previous_ms is the time the delta of a batched event
+    refers to, None for an event published on its own."""
+    f = {}
+    for number, _, value in fields(buf):
+        f[number] = value
+
+    if 9 in f:
+        event = {'habit_handle': f[9]}
+    else:
+        event = {'habit_id': f.get(2, b'').decode()}
+    event['data'] = int32(f.get(3, 0))
+
+    if 6 in f or 7 in f or 8 in f or (previous_ms is not None and 1 not in f):
+        # Current format, milliseconds
+        if previous_ms is None:
+            timestamp = f.get(6, 0)
+        else:
+            timestamp = previous_ms + zigzag(f.get(7, 0))
+        event['timestamp_ms'] = timestamp
+        if 8 in f:
+            event['start_ms'] = timestamp + zigzag(f[8])
+            event['stop_ms'] = timestamp
+    else:
+        # Earlier format, seconds
+        event['timestamp_ms'] = int32(f.get(1, 0)) * 1000
+        if 4 in f or 5 in f:
+            event['start_ms'] = int32(f.get(4, 0)) * 1000
+            event['stop_ms'] = int32(f.get(5, 0)) * 1000
+
+    return event
+
+
+def is_batch(buf):
+    # Field 1 of habit_batch is a submessage, in habit_data it is a varint.
+    try:
+        return any(number == 1 and wire == WIRE_LEN for number, wire, _ in fields(buf))
+    except ValueError:
+        return False
+
+
+def decode(buf):
+    """Decode a payload into a list of events."""
+    if not is_batch(buf):
+        return [decode_event(buf)]
+
+    base = 0
+    raw_events = []
+    for number, _, value in fields(buf):
+        if number == 1:
+            raw_events.append(value)
+        elif number == 2:
+            base = value
+
+    events = []
+    previous_ms = base
+    for raw in raw_events:
+        event = decode_event(raw, previous_ms)
+        previous_ms = event['timestamp_ms']
+        events.append(event)
+    return events
+
+
+def shadow_handles(shadow):
+    """Map the handles of the side configs in a shadow document to their habit IDs."""
+    handles = {}
+
+    def walk(node):
+        if isinstance(node, dict):
+            if isinstance(node.get('handle'), int) and isinstance(node.get('id'), str):
+                handles[node['handle']] = node['id']
+            for value in node.values():
+                walk(value)
+
+    walk(shadow)
+    return handles
+
+
+def resolve(event, handles):
+    handle = event.get('habit_handle')
+    if handle in handles:
+        event = {'habit_id': handles[handle], **event}
+    return event
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('payloads', nargs='*',
+                        help='Files with one binary payload each, stdin if none')
+    parser.add_argument('--hex', action='store_true',
+                        help='Payloads are hex strings, one per line')
+    parser.add_argument('--shadow',
+                        help='Device shadow document, JSON, to resolve habit handles with')
+    args = parser.parse_args()
+
+    handles = {}
+    if args.shadow:
+        with open(args.shadow) as f:
+            handles = shadow_handles(json.load(f))
+
+    if args.hex:
+        text = ''.join(open(p).read() for p in args.payloads) if args.payloads \
+            else sys.stdin.read()
+        payloads = [bytes.fromhex(line) for line in text.split() if line]
+    elif args.payloads:
+        payloads = [open(p, 'rb').read() for p in args.payloads]
+    else:
+        payloads = [sys.stdin.buffer.read()]
+
+    for payload in payloads:
+        for event in decode(payload):
+            print(json.dumps(resolve(event, handles)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""Generate a scenario for the emulated sensors.
+
+The device is turned to a random side, left to settle, tapped a number of times and
+turned again. Each line of the scenario is "time_ms,event[,value...]" with the events
+
+  gravity,x,y,z            gravity vector in milli-g
+  impact,magnitude         impact with a peak magnitude in milli-g
+  env,temp,humidity,press  milli-degrees Celsius, milli-percent and Pa
+  button                   press and release of the button
+"""
+
+import argparse
+import math
+import os
+import random
+
+from gen_side_table import read_normals
+
+
+def turn(out, t, start, end, duration, steps):
+    """Rotate gravity from start to end, as a hand turning the device would."""
+    for step in range(1, steps + 1):
+        f = step / steps
+        v = [a * (1 - f) + b * f for a, b in zip(start, end)]
+        length = math.sqrt(sum(c * c for c in v)) or 1.0
+        g = [round(1000 * c / length) for c in v]
+        out.append(f'{t + duration * step // steps},gravity,{g[0]},{g[1]},{g[2]}')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--normals', required=True, help='CSV file with one normal per line')
+    parser.add_argument('--output', required=True, help='Generated scenario CSV file')
+    parser.add_argument('--turns', type=int, default=20, help='Number of times the device is turned')
+    parser.add_argument('--taps', type=int, default=5, help='Maximum taps after each turn')
+    parser.add_argument('--tap-interval', type=int, default=250,
+                        help='Time between taps in milliseconds')
+    parser.add_argument('--settle', type=int, default=3000,
+                        help='Time the device rests before it is tapped in milliseconds')
+    parser.add_argument('--rest', type=int, default=8000,
+                        help='Time the device rests after the taps in milliseconds')
+    parser.add_argument('--seed', type=int, default=1, help='Random seed')
+    args = parser.parse_args()
+
+    normals = read_normals(args.normals)
+    rng = random.Random(args.seed)
+
+    lines = ['0,env,22000,40000,101325', '0,gravity,{},{},{}'.format(
+        *(round(1000 * c) for c in normals[0]))]
+    side = 0
+    t = 1000
+
+    for _ in range(args.turns):
+        new = rng.choice([s for s in range(len(normals)) if s != side])
+        turn(lines, t, normals[side], normals[new], 600, 6)
+        side = new
+        t += 600 + args.settle
+
+        for _ in range(rng.randint(0, args.taps)):
+            lines.append(f'{t},impact,{rng.randint(2000, 12000)}')
+            t += args.tap_interval
+
+        t += args.rest
+
+    with open(args.output, 'w') as f:
+        f.write(f'# Generated by gen_scenario.py from {os.path.basename(args.normals)}, '
+                f'seed {args.seed}\n')
+        f.write('\n'.join(lines) + '\n')
+
+
+if __name__ == '__main__':
+    main()
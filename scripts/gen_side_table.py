@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""Generate the side normal table and the side lookup table of the orientation pipeline.
+
+The lookup table maps a gravity direction to the side whose normal is closest to it.
+Directions are indexed by their octant, given by the signs of x, y and z, and by a coarse
+bin of |x| / (|x| + |y| + |z|) and |y| / (|x| + |y| + |z|) within the octant.
+"""
+
+import argparse
+import math
+import os
+
+
+def q15(value):
+    return max(-32768, min(32767, int(value * 32768 + (0.5 if value >= 0 else -0.5))))
+
+
+def read_normals(path):
+    normals = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith('#') or line[0].isalpha():
+                continue
+            normal = [float(v) for v in line.split(',')]
+            if len(normal) != 3:
+                raise ValueError(f'{path}: expected x,y,z, got "{line}"')
+            length = math.sqrt(sum(v * v for v in normal))
+            if abs(length - 1.0) > 0.01:
+                raise ValueError(f'{path}: "{line}" is not a unit vector')
+            normals.append(normal)
+    return normals
+
+
+def nearest(normals, direction):
+    dots = [sum(n[i] * direction[i] for i in range(3)) for n in normals]
+    return dots.index(max(dots))
+
+
+def lookup_table(normals, bins):
+    table = []
+    for octant in range(8):
+        sign = [-1 if octant & bit else 1 for bit in (4, 2, 1)]
+        for u in range(bins):
+            for v in range(bins):
+                # Center of the bin, clamped to the octant for bins that straddle its edge.
+                x = (u + 0.5) / bins
+                y = (v + 0.5) / bins
+                if x + y > 1.0:
+                    x, y = x / (x + y), y / (x + y)
+                direction = [sign[0] * x, sign[1] * y, sign[2] * (1.0 - x - y)]
+                table.append(nearest(normals, direction))
+    return table
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--normals', required=True, help='CSV file with one normal per line')
+    parser.add_argument('--sides', type=int, required=True,
+                        help='Number of sides of the configured geometry')
+    parser.add_argument('--bins', type=int, default=0,
+                        help='Bins per axis of the lookup table, 0 to leave it out')
+    parser.add_argument('--output', required=True, help='Generated C include file')
+    args = parser.parse_args()
+
+    normals = read_normals(args.normals)
+    name = os.path.basename(args.normals)
+    if len(normals) != args.sides:
+        parser.error(f'{name} holds {len(normals)} normals, the geometry has {args.sides} sides')
+
+    out = [f'/* Generated by gen_side_table.py from {name}, do not edit. */\n\n']
+    out.append('static const struct side_normal side_table_normals[] = {\n')
+    for side, normal in enumerate(normals):
+        values = ', '.join(str(q15(v)) for v in normal)
+        out.append(f'\t{{{values}}}, /* side {side} */\n')
+    out.append('};\n')
+
+    if args.bins:
+        table = lookup_table(normals, args.bins)
+        out.append(f'\n#define SIDE_TABLE_LOOKUP_BINS {args.bins}\n\n')
+        out.append(f'static const uint8_t side_table_lookup[{len(table)}] = {{\n')
+        for row in range(0, len(table), args.bins):
+            out.append('\t' + ', '.join(str(s) for s in table[row:row + args.bins]) + ',\n')
+        out.append('};\n')
+
+    with open(args.output, 'w') as f:
+        f.writelines(out)
+
+
+if __name__ == '__main__':
+    main()
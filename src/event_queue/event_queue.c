@@ -0,0 +1,485 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fcb.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/logging/log.h>
+#include <errno.h>
+#include <string.h>
+
+#include "event_queue.h"
+#include "simulation.h"
+#if defined(CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE_COMPRESS)
+#include "lzss.h"
+#endif
+
+LOG_MODULE_REGISTER(event_queue, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+#if !FIXED_PARTITION_EXISTS(event_queue)
+#error "The event queue needs an event_queue flash partition"
+#endif
+
+#define EVENT_QUEUE_PARTITION_ID FIXED_PARTITION_ID(event_queue)
+#define EVENT_QUEUE_MAGIC	 0x48425451
+#define EVENT_QUEUE_VERSION	 1
+#define MESSAGE_SIZE_MAX	 CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE_MESSAGE_SIZE
+
+/* Kind of the records that hold the read cursor. */
+#define KIND_ACK 0xff
+
+/* The message is compressed, raw_len holds its length. */
+#define RECORD_COMPRESSED BIT(0)
+
+/* Compressed records are read from flash and decoded in chunks of this size. */
+#define DECODE_CHUNK_SIZE 32
+
+/* A record is a header followed by the message. */
+struct record_header {
+	/* Sequence number of the message, or of the last message sent for an ACK. */
+	uint32_t seq;
+	uint8_t kind;
+	/* Zero in records written without compression support. */
+	uint8_t flags;
+	uint16_t raw_len;
+};
+
+/* Compression statistics since boot. */
+struct compress_stats {
+	uint32_t records;
+	uint32_t raw_bytes;
+	uint32_t stored_bytes;
+	uint64_t compress_cycles;
+	uint32_t decoded;
+	uint64_t decode_cycles;
+};
+
+static struct fcb fcb;
+static struct flash_sector sectors[CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE_SECTORS];
+static bool mounted;
+/* Records are padded to the write block size here before they are written, and read
+ * back here before they are sent.
+ */
+static uint8_t record_buffer[ROUND_UP(sizeof(struct record_header) + MESSAGE_SIZE_MAX, 16)]
+	__aligned(4);
+static uint32_t next_seq = 1;
+static uint32_t acked_seq;
+static __maybe_unused struct compress_stats stats;
+
+static int record_header_read(const struct fcb_entry *loc, struct record_header *header)
+{
+	if (loc->fe_data_len < sizeof(*header)) {
+		return -EINVAL;
+	}
+
+	return flash_area_read(fcb.fap, FCB_ENTRY_FA_DATA_OFF(*loc), header, sizeof(*header));
+}
+
+static int record_append(const struct record_header *header, const uint8_t *data, size_t len);
+
+static int ack_append(void)
+{
+	struct record_header header = {
+		.seq = acked_seq,
+		.kind = KIND_ACK,
+	};
+
+	return record_append(&header, NULL, 0);
+}
+
+static int sector_seq_max(struct fcb_entry_ctx *loc_ctx, void *arg)
+{
+	struct record_header header;
+	uint32_t *seq_max = arg;
+
+	if (record_header_read(&loc_ctx->loc, &header) == 0 && header.kind != KIND_ACK) {
+		*seq_max = MAX(*seq_max, header.seq);
+	}
+
+	return 0;
+}
+
+/* Highest sequence number of the messages in a sector, 0 if it holds none. */
+static uint32_t sector_seq_max_get(struct flash_sector *sector)
+{
+	uint32_t seq_max = 0;
+
+	(void)fcb_walk(&fcb, sector, sector_seq_max, &seq_max);
+
+	return seq_max;
+}
+
+/* Erase the oldest sectors as long as they only hold sent messages. The active sector
+ * is kept.
+ */
+static void sent_sectors_erase(void)
+{
+	while (fcb.f_oldest != fcb.f_active.fe_sector &&
+	       sector_seq_max_get(fcb.f_oldest) <= acked_seq) {
+		if (fcb_rotate(&fcb)) {
+			break;
+		}
+		simulation_count(SIMULATION_QUEUE_ERASE);
+	}
+}
+
+/* Make room by erasing the oldest sector, unsent messages in it are lost. */
+static int oldest_sector_drop(void)
+{
+	uint32_t seq_max = sector_seq_max_get(fcb.f_oldest);
+	int err;
+
+	err = fcb_rotate(&fcb);
+	if (err) {
+		return err;
+	}
+	simulation_count(SIMULATION_QUEUE_ERASE);
+
+	if (seq_max > acked_seq) {
+		LOG_WRN("Queue full, %u unsent messages dropped", seq_max - acked_seq);
+		acked_seq = seq_max;
+	}
+
+	return 0;
+}
+
+/* Write the record staged in record_buffer, with a message of len bytes. */
+static int record_write(size_t len)
+{
+	size_t record_len = sizeof(struct record_header) + len;
+	size_t write_len = ROUND_UP(record_len, fcb.f_align);
+	bool rotated = false;
+	struct fcb_entry loc;
+	int err;
+
+	if (write_len > sizeof(record_buffer)) {
+		return -EMSGSIZE;
+	}
+
+	memset(&record_buffer[record_len], fcb.f_erase_value, write_len - record_len);
+
+	err = fcb_append(&fcb, record_len, &loc);
+	if (err == -ENOSPC) {
+		err = oldest_sector_drop();
+		if (err == 0) {
+			rotated = true;
+			err = fcb_append(&fcb, record_len, &loc);
+		}
+	}
+	if (err) {
+		return err;
+	}
+
+	err = flash_area_write(fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), record_buffer, write_len);
+	if (err) {
+		return err;
+	}
+
+	err = fcb_append_finish(&fcb, &loc);
+	if (err) {
+		return err;
+	}
+	simulation_count(SIMULATION_QUEUE_WRITE);
+
+	/* The erased sector may have held the latest ACK. */
+	if (rotated && acked_seq) {
+		return ack_append();
+	}
+
+	return 0;
+}
+
+static int record_append(const struct record_header *header, const uint8_t *data, size_t len)
+{
+	if (len > MESSAGE_SIZE_MAX) {
+		return -EMSGSIZE;
+	}
+
+	memcpy(record_buffer, header, sizeof(*header));
+	if (len) {
+		memcpy(&record_buffer[sizeof(*header)], data, len);
+	}
+
+	return record_write(len);
+}
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE_COMPRESS)
+/* Compress the message straight into record_buffer, or store it as it is when that
+ * does not make it smaller.
+ */
+static int record_append_compressed(struct record_header *header, const uint8_t *data,
+				    size_t len)
+{
+	uint32_t start = k_cycle_get_32();
+	int compressed_len;
+
+	if (len > MESSAGE_SIZE_MAX) {
+		return -EMSGSIZE;
+	}
+
+	compressed_len = lzss_compress(data, len, &record_buffer[sizeof(*header)],
+				       len > 0 ? len - 1 : 0);
+
+	stats.compress_cycles += k_cycle_get_32() - start;
+	stats.records++;
+	stats.raw_bytes += len;
+
+	if (compressed_len < 0) {
+		stats.stored_bytes += len;
+		return record_append(header, data, len);
+	}
+
+	stats.stored_bytes += compressed_len;
+	header->flags |= RECORD_COMPRESSED;
+	header->raw_len = len;
+	memcpy(record_buffer, header, sizeof(*header));
+
+	return record_write(compressed_len);
+}
+
+/* Decode a compressed message into record_buffer, reading it from flash in chunks. */
+static int record_decompress(const struct fcb_entry *loc, const struct record_header *header)
+{
+	off_t offset = FCB_ENTRY_FA_DATA_OFF(*loc) + sizeof(*header);
+	size_t left = loc->fe_data_len - sizeof(*header);
+	uint32_t start = k_cycle_get_32();
+	uint8_t chunk[DECODE_CHUNK_SIZE];
+	struct lzss_decoder dec;
+	int err;
+
+	lzss_decoder_init(&dec, record_buffer, MIN(header->raw_len, sizeof(record_buffer)));
+
+	while (left > 0) {
+		size_t chunk_len = MIN(left, sizeof(chunk));
+
+		err = flash_area_read(fcb.fap, offset, chunk, chunk_len);
+		if (err) {
+			return err;
+		}
+
+		err = lzss_decode(&dec, chunk, chunk_len);
+		if (err) {
+			return err;
+		}
+
+		offset += chunk_len;
+		left -= chunk_len;
+	}
+
+	stats.decode_cycles += k_cycle_get_32() - start;
+	stats.decoded++;
+
+	return dec.out_len == header->raw_len ? 0 : -EBADMSG;
+}
+
+static void compress_stats_log(void)
+{
+	if (stats.records == 0 || stats.stored_bytes == 0) {
+		return;
+	}
+
+	LOG_INF("Compression %u.%02u:1 over %u records, %u cycles per record",
+		stats.raw_bytes / stats.stored_bytes,
+		(stats.raw_bytes % stats.stored_bytes) * 100 / stats.stored_bytes,
+		stats.records, (uint32_t)(stats.compress_cycles / stats.records));
+
+	if (stats.decoded) {
+		LOG_INF("Decompression %u cycles per record over %u records",
+			(uint32_t)(stats.decode_cycles / stats.decoded), stats.decoded);
+	}
+}
+#endif /* defined(CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE_COMPRESS) */
+
+static int record_send(const struct fcb_entry *loc, const struct record_header *header,
+		       event_queue_send_t send)
+{
+	off_t offset = FCB_ENTRY_FA_DATA_OFF(*loc) + sizeof(*header);
+	size_t len = loc->fe_data_len - sizeof(*header);
+
+	if (header->flags & RECORD_COMPRESSED) {
+		/* Decoded by the caller. */
+		return send(header->kind, record_buffer, header->raw_len);
+	}
+
+	/* Read through the flash area, the partition may be on external flash. */
+	int err = flash_area_read(fcb.fap, offset, record_buffer, len);
+
+	if (err) {
+		return err;
+	}
+
+	return send(header->kind, record_buffer, len);
+}
+
+static int fcb_mount(void)
+{
+	uint32_t sector_count = ARRAY_SIZE(sectors);
+	int err;
+
+	err = flash_area_get_sectors(EVENT_QUEUE_PARTITION_ID, &sector_count, sectors);
+	if (err) {
+		LOG_ERR("Failed to get the partition sectors, error: %d", err);
+		return err;
+	}
+
+	fcb.f_magic = EVENT_QUEUE_MAGIC;
+	fcb.f_version = EVENT_QUEUE_VERSION;
+	fcb.f_sector_cnt = sector_count;
+	fcb.f_scratch_cnt = 0;
+	fcb.f_sectors = sectors;
+
+	return fcb_init(EVENT_QUEUE_PARTITION_ID, &fcb);
+}
+
+int event_queue_init(void)
+{
+	struct fcb_entry loc = {0};
+	struct record_header header;
+	const struct flash_area *fa;
+	int err;
+
+	err = fcb_mount();
+	if (err) {
+		/* Not formatted as a queue, or written by another version, start over. */
+		LOG_WRN("Erasing the event queue, error: %d", err);
+
+		err = flash_area_open(EVENT_QUEUE_PARTITION_ID, &fa);
+		if (err) {
+			return err;
+		}
+
+		err = flash_area_erase(fa, 0, fa->fa_size);
+		flash_area_close(fa);
+		if (err) {
+			return err;
+		}
+
+		for (size_t i = 0; i < ARRAY_SIZE(sectors); i++) {
+			simulation_count(SIMULATION_QUEUE_ERASE);
+		}
+
+		err = fcb_mount();
+		if (err) {
+			LOG_ERR("Failed to mount the event queue, error: %d", err);
+			return err;
+		}
+	}
+
+	while (fcb_getnext(&fcb, &loc) == 0) {
+		if (record_header_read(&loc, &header)) {
+			continue;
+		}
+
+		if (header.kind == KIND_ACK) {
+			acked_seq = header.seq;
+		} else {
+			next_seq = header.seq + 1;
+		}
+	}
+
+	/* The messages of the last ACK may all have been dropped. */
+	next_seq = MAX(next_seq, acked_seq + 1);
+	mounted = true;
+
+	LOG_INF("%u messages pending", event_queue_pending());
+
+	return 0;
+}
+
+int event_queue_append(uint8_t kind, const uint8_t *data, size_t len)
+{
+	struct record_header header = {
+		.seq = next_seq,
+		.kind = kind,
+	};
+	int err;
+
+	if (!mounted) {
+		return -ENODEV;
+	}
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE_COMPRESS)
+	err = record_append_compressed(&header, data, len);
+#else
+	err = record_append(&header, data, len);
+#endif
+	if (err) {
+		return err;
+	}
+
+	next_seq++;
+
+	return 0;
+}
+
+int event_queue_replay(event_queue_send_t send)
+{
+	struct fcb_entry loc = {0};
+	struct record_header header;
+	uint32_t sent_seq = acked_seq;
+	int sent = 0;
+	int err = 0;
+
+	if (!mounted) {
+		return -ENODEV;
+	}
+
+	while (fcb_getnext(&fcb, &loc) == 0) {
+		if (record_header_read(&loc, &header) || header.kind == KIND_ACK ||
+		    header.seq <= acked_seq) {
+			continue;
+		}
+
+		if (header.flags & RECORD_COMPRESSED) {
+#if defined(CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE_COMPRESS)
+			int decode_err = record_decompress(&loc, &header);
+#else
+			int decode_err = -ENOTSUP;
+#endif
+			/* A message that cannot be decoded would block the queue for good. */
+			if (decode_err) {
+				LOG_ERR("Message %u dropped, error: %d", header.seq, decode_err);
+				sent_seq = header.seq;
+				continue;
+			}
+		}
+
+		err = record_send(&loc, &header, send);
+		if (err) {
+			break;
+		}
+
+		sent_seq = header.seq;
+		sent++;
+	}
+
+	if (sent_seq != acked_seq) {
+		acked_seq = sent_seq;
+
+		/* Room for the ACK is made from sent messages first. */
+		sent_sectors_erase();
+
+		/* Without the ACK the messages are sent again after a reboot. */
+		int ack_err = ack_append();
+
+		if (ack_err) {
+			LOG_ERR("Failed to store the read cursor, error: %d", ack_err);
+		}
+	}
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE_COMPRESS)
+	if (sent > 0) {
+		compress_stats_log();
+	}
+#endif
+
+	return err ? err : sent;
+}
+
+uint32_t event_queue_pending(void)
+{
+	return mounted ? next_seq - 1 - acked_seq : 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Persistent queue of outbound messages in a dedicated flash partition.
+ *
+ * Messages that could not be published are appended to a flash circular buffer (FCB) in
+ * the event_queue partition and replayed in order once the cloud connection is back. The
+ * read cursor is stored by appending acknowledgment records, so nothing is ever written
+ * in place, and it survives a reboot. A message counts as sent once the send callback
+ * returns 0. Published at QoS 0 that only means it was written to the socket, so a
+ * message lost after that is not sent again; there is no delivery guarantee. Messages
+ * sent right before a reboot, and not yet acknowledged, are sent again.
+ *
+ * When the partition is full, the oldest sector is erased, with any unsent messages in
+ * it. The functions must not be called concurrently.
+ */
+
+#ifndef EVENT_QUEUE_H__
+#define EVENT_QUEUE_H__
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Send a queued message.
+ *
+ * @details The message may point straight into flash and is only valid during the call.
+ *
+ * @param[in] kind Kind of the message, as given to event_queue_append().
+ * @param[in] data Message.
+ * @param[in] len Length of the message in bytes.
+ *
+ * @return 0 on success, a negative error code to stop the replay.
+ */
+typedef int (*event_queue_send_t)(uint8_t kind, const uint8_t *data, size_t len);
+
+/**
+ * @brief Mount the queue and find its read cursor.
+ *
+ * @return 0 on success or negative error value on failure.
+ */
+int event_queue_init(void);
+
+/**
+ * @brief Append a message.
+ *
+ * @param[in] kind Kind of the message, for instance the topic it belongs to.
+ * @param[in] data Message.
+ * @param[in] len Length of the message in bytes, at most
+ *		  CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE_MESSAGE_SIZE.
+ *
+ * @return 0 on success, -EMSGSIZE if the message is too large, or another negative error
+ *	   value if it could not be stored.
+ */
+int event_queue_append(uint8_t kind, const uint8_t *data, size_t len);
+
+/**
+ * @brief Send the queued messages in order.
+ *
+ * @details Stops at the first message that fails to send, it is the first one sent by
+ *	    the next replay. Sectors holding only sent messages are erased.
+ *
+ * @param[in] send Callback that sends one message.
+ *
+ * @return The number of messages sent, or a negative error value if the replay stopped
+ *	   early.
+ */
+int event_queue_replay(event_queue_send_t send);
+
+/**
+ * @brief Number of messages waiting to be sent.
+ */
+uint32_t event_queue_pending(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_QUEUE_H__ */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <errno.h>
+
+#include "feedback.h"
+
+LOG_MODULE_REGISTER(feedback, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+K_MSGQ_DEFINE(feedback_queue, sizeof(const struct feedback_pattern *),
+	      CONFIG_AWS_IOT_SAMPLE_FEEDBACK_QUEUE_SIZE, sizeof(void *));
+
+static void feedback_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(feedback_work, feedback_work_fn);
+
+static const struct pwm_dt_spec *buzzer_pwm;
+static const struct gpio_dt_spec *led_gpio;
+
+/* Only accessed from the work item */
+static const struct feedback_pattern *current;
+static size_t step;
+static int64_t step_end;
+
+static void tone_set(uint16_t frequency, uint8_t volume)
+{
+	uint32_t period_ns, duty_cycle_ns;
+	int division_factor;
+
+	if (frequency == 0) {
+		period_ns = 0;
+		duty_cycle_ns = 0;
+	} else {
+		/* The volume is set by the duty cycle, from 1/32 to 1/1 of the period. */
+		division_factor = 32 - volume / 3;
+		if (volume > 95) {
+			division_factor = 1;
+		} else if (volume < 5) {
+			division_factor = 32;
+		}
+
+		period_ns = NSEC_PER_SEC / frequency;
+		duty_cycle_ns = period_ns / division_factor;
+	}
+
+	if (buzzer_pwm != NULL && pwm_set_dt(buzzer_pwm, period_ns, duty_cycle_ns)) {
+		LOG_ERR("Failed to set the tone");
+	}
+}
+
+static void step_start(const struct feedback_step *s)
+{
+	tone_set(s->frequency, s->volume);
+
+	if (led_gpio != NULL && s->led != FEEDBACK_LED_KEEP) {
+		gpio_pin_set_dt(led_gpio, s->led == FEEDBACK_LED_ON);
+	}
+
+	step_end = k_uptime_get() + s->duration;
+	k_work_schedule(&feedback_work, K_MSEC(s->duration));
+}
+
+static void feedback_work_fn(struct k_work *work)
+{
+	int64_t remaining = step_end - k_uptime_get();
+
+	/* Queuing a pattern kicks the work item, which must not cut the current step short. */
+	if (current != NULL && remaining > 0) {
+		k_work_schedule(&feedback_work, K_MSEC(remaining));
+		return;
+	}
+
+	if (current != NULL && ++step < current->count) {
+		step_start(&current->steps[step]);
+		return;
+	}
+
+	if (k_msgq_get(&feedback_queue, &current, K_NO_WAIT)) {
+		current = NULL;
+		tone_set(0, 0);
+		return;
+	}
+
+	step = 0;
+	step_start(&current->steps[0]);
+}
+
+int feedback_init(const struct pwm_dt_spec *buzzer, const struct gpio_dt_spec *led)
+{
+	led_gpio = led;
+
+	/* Patterns are still played on the LED without the buzzer. */
+	if (buzzer->dev == NULL) {
+		LOG_WRN("No buzzer on this board");
+		return -ENODEV;
+	}
+
+	if (!pwm_is_ready_dt(buzzer)) {
+		LOG_ERR("PWM device %s is not ready", buzzer->dev->name);
+		return -ENODEV;
+	}
+
+	buzzer_pwm = buzzer;
+
+	return 0;
+}
+
+int feedback_play(const struct feedback_pattern *pattern)
+{
+	if (pattern->count == 0) {
+		return 0;
+	}
+
+	if (k_msgq_put(&feedback_queue, &pattern, K_NO_WAIT)) {
+		LOG_DBG("Feedback queue full, pattern dropped");
+		return -ENOMSG;
+	}
+
+	k_work_schedule(&feedback_work, K_NO_WAIT);
+
+	return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Sequencer that plays buzzer and LED patterns in the background.
+ *
+ * Patterns are constant data. Playing one only queues it, each step is then started
+ * from a delayable work item when the previous one has run out, so callers never wait
+ * for the buzzer.
+ */
+
+#ifndef FEEDBACK_H__
+#define FEEDBACK_H__
+
+#include <zephyr/types.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/pwm.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief LED state during a step. */
+enum feedback_led {
+	/** Leave the LED as it is. */
+	FEEDBACK_LED_KEEP,
+	FEEDBACK_LED_ON,
+	FEEDBACK_LED_OFF,
+};
+
+/** @brief One note of a pattern. */
+struct feedback_step {
+	/** Tone frequency in Hz, 0 for silence. */
+	uint16_t frequency;
+	/** Duration in milliseconds. */
+	uint16_t duration;
+	/** Volume in percent. */
+	uint8_t volume;
+	/** LED state from the start of the step. */
+	enum feedback_led led;
+};
+
+/** @brief Sequence of steps played one after the other. */
+struct feedback_pattern {
+	const struct feedback_step *steps;
+	size_t count;
+};
+
+/** @brief Define a constant pattern from a list of steps. */
+#define FEEDBACK_PATTERN_DEFINE(name, ...)                                                         \
+	static const struct feedback_step name##_steps[] = {__VA_ARGS__};                         \
+	static const struct feedback_pattern name = {                                              \
+		.steps = name##_steps,                                                             \
+		.count = ARRAY_SIZE(name##_steps),                                                 \
+	}
+
+/**
+ * @brief Set the buzzer and the LED patterns are played on.
+ *
+ * @param[in] buzzer Buzzer PWM.
+ * @param[in] led LED, or NULL to ignore the LED state of the steps.
+ *
+ * @return 0 on success, -ENODEV if the buzzer is not ready. Patterns are then only
+ *	   shown on the LED.
+ */
+int feedback_init(const struct pwm_dt_spec *buzzer, const struct gpio_dt_spec *led);
+
+/**
+ * @brief Queue a pattern and return immediately. It starts once the patterns queued
+ *	  before it have been played.
+ *
+ * @details Can be called from interrupt context.
+ *
+ * @param[in] pattern Pattern, must stay valid until it has been played.
+ *
+ * @return 0 on success, -ENOMSG if the queue is full and the pattern was dropped.
+ */
+int feedback_play(const struct feedback_pattern *pattern);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FEEDBACK_H__ */
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <errno.h>
+#include <string.h>
+#include <pb_encode.h>
+#include <src/data.pb.h>
+
+#include "habit_batch.h"
+
+LOG_MODULE_REGISTER(habit_batch, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+#define BATCH_EVENTS CONFIG_AWS_IOT_SAMPLE_HABIT_BATCH_EVENTS
+#define BATCH_SIZE   CONFIG_AWS_IOT_SAMPLE_HABIT_BATCH_SIZE
+#define BATCH_AGE    K_SECONDS(CONFIG_AWS_IOT_SAMPLE_HABIT_BATCH_AGE_SECONDS)
+#define BATCH_RETRY  K_SECONDS(CONFIG_AWS_IOT_SAMPLE_CONNECTION_RETRY_TIMEOUT_SECONDS)
+
+/* Tags of the events and base_timestamp_ms fields, field numbers below 16. */
+#define EVENT_TAG_SIZE 1
+#define BASE_TAG_SIZE  1
+
+struct batch_entry {
+	struct habit_event event;
+	char habit_id[HABIT_BATCH_ID_LEN_MAX + 1];
+};
+
+/* The habit ID of an entry is copied into the fixed size field of data.options. */
+BUILD_ASSERT(HABIT_BATCH_ID_LEN_MAX + 1 == SIZEOF_FIELD(habit_data, habit_id),
+	     "HABIT_BATCH_ID_LEN_MAX does not match habit_data.habit_id in data.options");
+
+static struct batch_entry entries[BATCH_EVENTS];
+static size_t entry_count;
+/* Encoded size of the habit_batch message holding the entries. */
+static size_t batch_size;
+static uint8_t batch_buffer[BATCH_SIZE];
+static habit_batch_send_t send_batch;
+
+static void age_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(age_work, age_work_fn);
+
+/* Times in a batch are deltas, to the previous event and within the event, so they are
+ * encoded as short zigzag varints.
+ */
+static void event_to_message(const struct habit_event *event, int64_t previous_ms,
+			     habit_data *message)
+{
+	*message = (habit_data)habit_data_init_zero;
+	message->timestamp_delta_ms = event->timestamp_ms - previous_ms;
+	message->data = event->data;
+	if (event->start_ms) {
+		message->start_delta_ms = event->start_ms - event->timestamp_ms;
+	}
+	if (event->habit_handle) {
+		message->habit_handle = event->habit_handle;
+	} else {
+		strcpy(message->habit_id, event->habit_id);
+	}
+}
+
+static bool encode_events(pb_ostream_t *stream, const pb_field_t *field, void *const *arg)
+{
+	int64_t previous_ms = entries[0].event.timestamp_ms;
+
+	for (size_t i = 0; i < entry_count; i++) {
+		habit_data message;
+
+		event_to_message(&entries[i].event, previous_ms, &message);
+		previous_ms = entries[i].event.timestamp_ms;
+
+		if (!pb_encode_tag_for_field(stream, field) ||
+		    !pb_encode_submessage(stream, habit_data_fields, &message)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Bytes an event adds to the batch, its tag, length and message, and the base timestamp
+ * for the first event.
+ */
+static size_t event_encoded_size(const struct habit_event *event)
+{
+	pb_ostream_t sizing = PB_OSTREAM_SIZING;
+	int64_t previous_ms = event->timestamp_ms;
+	size_t base_size = 0;
+	habit_data message;
+	size_t size;
+
+	if (entry_count > 0) {
+		previous_ms = entries[entry_count - 1].event.timestamp_ms;
+	} else {
+		if (!pb_encode_varint(&sizing, event->timestamp_ms)) {
+			return SIZE_MAX;
+		}
+
+		base_size = BASE_TAG_SIZE + sizing.bytes_written;
+		sizing = (pb_ostream_t)PB_OSTREAM_SIZING;
+	}
+
+	event_to_message(event, previous_ms, &message);
+
+	if (!pb_get_encoded_size(&size, habit_data_fields, &message) ||
+	    !pb_encode_varint(&sizing, size)) {
+		return SIZE_MAX;
+	}
+
+	return base_size + EVENT_TAG_SIZE + sizing.bytes_written + size;
+}
+
+static void age_work_fn(struct k_work *work)
+{
+	(void)habit_batch_flush();
+}
+
+void habit_batch_init(habit_batch_send_t send)
+{
+	send_batch = send;
+}
+
+int habit_batch_flush(void)
+{
+	habit_batch batch = habit_batch_init_zero;
+	pb_ostream_t stream = pb_ostream_from_buffer(batch_buffer, sizeof(batch_buffer));
+	int err;
+
+	if (entry_count == 0) {
+		return 0;
+	}
+
+	batch.events.funcs.encode = &encode_events;
+	batch.base_timestamp_ms = entries[0].event.timestamp_ms;
+
+	if (!pb_encode(&stream, habit_batch_fields, &batch)) {
+		/* Not expected, the size of every event is checked when it is added. */
+		LOG_ERR("Encoding failed: %s, %zu events dropped", PB_GET_ERROR(&stream),
+			entry_count);
+		entry_count = 0;
+		batch_size = 0;
+		return -EMSGSIZE;
+	}
+
+	err = send_batch(batch_buffer, stream.bytes_written);
+	if (err) {
+		LOG_WRN("Sending %zu events failed, error: %d, retrying later", entry_count, err);
+		k_work_reschedule(&age_work, BATCH_RETRY);
+		return err;
+	}
+
+	LOG_INF("Sent %zu events in %zu bytes", entry_count, stream.bytes_written);
+
+	entry_count = 0;
+	batch_size = 0;
+	k_work_cancel_delayable(&age_work);
+
+	return 0;
+}
+
+int habit_batch_add(const struct habit_event *event)
+{
+	struct batch_entry *entry;
+	size_t size;
+
+	if (!event->habit_handle && strlen(event->habit_id) > HABIT_BATCH_ID_LEN_MAX) {
+		return -EMSGSIZE;
+	}
+
+	size = event_encoded_size(event);
+
+	if (entry_count == BATCH_EVENTS || batch_size + size > BATCH_SIZE) {
+		if (habit_batch_flush()) {
+			return -ENOBUFS;
+		}
+
+		/* The event now starts a batch, its delta is relative to the base. */
+		size = event_encoded_size(event);
+	}
+
+	if (size > BATCH_SIZE) {
+		return -EMSGSIZE;
+	}
+
+	entry = &entries[entry_count++];
+	entry->event = *event;
+	if (event->habit_handle) {
+		entry->habit_id[0] = '\0';
+	} else {
+		strcpy(entry->habit_id, event->habit_id);
+	}
+	entry->event.habit_id = entry->habit_id;
+	batch_size += size;
+
+	/* The age of a batch is the age of its first event. */
+	if (entry_count == 1) {
+		k_work_reschedule(&age_work, BATCH_AGE);
+	}
+
+	if (entry_count == BATCH_EVENTS) {
+		(void)habit_batch_flush();
+	}
+
+	return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Batching of habit events into one habit_batch message.
+ *
+ * Events are collected until the batch reaches CONFIG_AWS_IOT_SAMPLE_HABIT_BATCH_EVENTS
+ * events or CONFIG_AWS_IOT_SAMPLE_HABIT_BATCH_SIZE encoded bytes, or until its first
+ * event is CONFIG_AWS_IOT_SAMPLE_HABIT_BATCH_AGE_SECONDS old, and are then sent as a
+ * single message. A batch that could not be sent is kept and sent again later.
+ *
+ * All functions, and the send callback, run in the system work queue.
+ */
+
+#ifndef HABIT_BATCH_H__
+#define HABIT_BATCH_H__
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Longest habit ID a batched event can hold. */
+#define HABIT_BATCH_ID_LEN_MAX 47
+
+/** @brief One habit event, the fields of a habit_data message. */
+struct habit_event {
+	/** Time of the event in milliseconds since the epoch. */
+	int64_t timestamp_ms;
+	int32_t data;
+	/** Start of a TIME habit session in milliseconds since the epoch, 0 if none. */
+	int64_t start_ms;
+	/** Habit ID, copied when the event is added to the batch. Not sent with a handle. */
+	const char *habit_id;
+	/** Handle of the habit assigned in the device shadow, 0 to send the habit ID. */
+	uint32_t habit_handle;
+};
+
+/**
+ * @brief Send an encoded habit_batch message.
+ *
+ * @param[in] buf Message.
+ * @param[in] len Length of the message in bytes.
+ *
+ * @return 0 on success, a negative error code if the message must be sent again later.
+ */
+typedef int (*habit_batch_send_t)(const uint8_t *buf, size_t len);
+
+/**
+ * @brief Initialize the batching stage.
+ *
+ * @param[in] send Callback that sends a batch.
+ */
+void habit_batch_init(habit_batch_send_t send);
+
+/**
+ * @brief Add an event to the batch.
+ *
+ * @details The batch is sent right away if the event fills it up.
+ *
+ * @param[in] event Event.
+ *
+ * @return 0 on success, -EMSGSIZE if the event cannot be batched because its habit ID is
+ *	   longer than HABIT_BATCH_ID_LEN_MAX or it is larger than a batch, -ENOBUFS if the
+ *	   batch is full and could not be sent. The event must then be sent on its own.
+ */
+int habit_batch_add(const struct habit_event *event);
+
+/**
+ * @brief Send the batch now if it holds any event.
+ *
+ * @return 0 on success or if the batch is empty, otherwise the error of the send
+ *	   callback. The batch is kept and sent again later.
+ */
+int habit_batch_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HABIT_BATCH_H__ */
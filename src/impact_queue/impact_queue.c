@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <errno.h>
+
+#include "impact_queue.h"
+
+#define QUEUE_SIZE CONFIG_AWS_IOT_SAMPLE_IMPACT_QUEUE_SIZE
+#define QUEUE_MASK (QUEUE_SIZE - 1)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(QUEUE_SIZE), "Impact queue size must be a power of two");
+
+static struct impact_record records[QUEUE_SIZE];
+
+/* Free running counters, head is only written by the producer and tail only by the
+ * consumer. A record is written before head publishes it and read before tail releases
+ * its slot, atomic accesses are sequentially consistent.
+ */
+static atomic_t head;
+static atomic_t tail;
+static atomic_t overflow;
+
+int impact_queue_put(const struct impact_record *record)
+{
+	uint32_t h = atomic_get(&head);
+
+	if (h - (uint32_t)atomic_get(&tail) >= QUEUE_SIZE) {
+		atomic_inc(&overflow);
+		return -ENOBUFS;
+	}
+
+	records[h & QUEUE_MASK] = *record;
+	atomic_set(&head, h + 1);
+
+	return 0;
+}
+
+int impact_queue_get(struct impact_record *record)
+{
+	uint32_t t = atomic_get(&tail);
+
+	if (t == (uint32_t)atomic_get(&head)) {
+		return -ENODATA;
+	}
+
+	*record = records[t & QUEUE_MASK];
+	atomic_set(&tail, t + 1);
+
+	return 0;
+}
+
+uint32_t impact_queue_overflow_take(void)
+{
+	return atomic_clear(&overflow);
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Lock-free queue of impacts between the impact trigger and the habit counter.
+ *
+ * There must be a single producer and a single consumer, which may run in different
+ * contexts. Both sides are constant time and never allocate. Impacts that do not fit
+ * in the queue are not lost, they are counted and can be taken by the consumer.
+ */
+
+#ifndef IMPACT_QUEUE_H__
+#define IMPACT_QUEUE_H__
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief One impact. */
+struct impact_record {
+	/** Uptime in milliseconds at which the impact started. */
+	int64_t timestamp;
+	/** Peak magnitude in milli-g. */
+	uint32_t magnitude;
+};
+
+/**
+ * @brief Add an impact, called by the producer.
+ *
+ * @details Can be called from interrupt context.
+ *
+ * @param[in] record Impact.
+ *
+ * @return 0 on success, -ENOBUFS if the queue is full. The impact is then only
+ *	   counted, see impact_queue_overflow_take().
+ */
+int impact_queue_put(const struct impact_record *record);
+
+/**
+ * @brief Take the oldest impact, called by the consumer.
+ *
+ * @param[out] record Impact.
+ *
+ * @return 0 on success, -ENODATA if the queue is empty.
+ */
+int impact_queue_get(struct impact_record *record);
+
+/**
+ * @brief Take the number of impacts that did not fit in the queue, called by the
+ *	  consumer.
+ *
+ * @return Number of impacts dropped since the last call.
+ */
+uint32_t impact_queue_overflow_take(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPACT_QUEUE_H__ */
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <errno.h>
+
+#include "lzss.h"
+
+#define GROUP_ITEMS 8
+
+/* Longest match for the data at pos, searched back through the whole window. */
+static size_t match_find(const uint8_t *in, size_t in_len, size_t pos, size_t *distance)
+{
+	size_t window = MIN(pos, LZSS_WINDOW_SIZE);
+	size_t limit = MIN(in_len - pos, LZSS_MATCH_MAX);
+	size_t best = 0;
+
+	for (size_t d = 1; d <= window; d++) {
+		const uint8_t *ref = &in[pos - d];
+		size_t len = 0;
+
+		/* Matches may overlap the data they produce, like runs. */
+		while (len < limit && ref[len] == in[pos + len]) {
+			len++;
+		}
+
+		if (len > best) {
+			best = len;
+			*distance = d;
+
+			if (len == limit) {
+				break;
+			}
+		}
+	}
+
+	return best;
+}
+
+int lzss_compress(const uint8_t *in, size_t in_len, uint8_t *out, size_t out_size)
+{
+	size_t pos = 0;
+	size_t out_len = 0;
+	size_t flags_pos = 0;
+	uint8_t items = GROUP_ITEMS;
+
+	while (pos < in_len) {
+		size_t distance = 0;
+		size_t len = match_find(in, in_len, pos, &distance);
+
+		if (items == GROUP_ITEMS) {
+			if (out_len == out_size) {
+				return -ENOSPC;
+			}
+
+			flags_pos = out_len++;
+			out[flags_pos] = 0;
+			items = 0;
+		}
+
+		if (len >= LZSS_MATCH_MIN) {
+			if (out_size - out_len < 2) {
+				return -ENOSPC;
+			}
+
+			out[flags_pos] |= BIT(items);
+			out[out_len++] = distance - 1;
+			out[out_len++] = len - LZSS_MATCH_MIN;
+			pos += len;
+		} else {
+			if (out_len == out_size) {
+				return -ENOSPC;
+			}
+
+			out[out_len++] = in[pos++];
+		}
+
+		items++;
+	}
+
+	return out_len;
+}
+
+void lzss_decoder_init(struct lzss_decoder *dec, uint8_t *out, size_t out_size)
+{
+	*dec = (struct lzss_decoder){
+		.out = out,
+		.out_size = out_size,
+	};
+}
+
+static int match_copy(struct lzss_decoder *dec, size_t distance, size_t len)
+{
+	if (distance > dec->out_len) {
+		return -EINVAL;
+	}
+
+	if (len > dec->out_size - dec->out_len) {
+		return -ENOSPC;
+	}
+
+	/* Byte by byte, a match may overlap the data it produces. */
+	for (size_t i = 0; i < len; i++) {
+		dec->out[dec->out_len] = dec->out[dec->out_len - distance];
+		dec->out_len++;
+	}
+
+	return 0;
+}
+
+int lzss_decode(struct lzss_decoder *dec, const uint8_t *in, size_t in_len)
+{
+	size_t i = 0;
+	int err;
+
+	if (dec->split_match && in_len > 0) {
+		err = match_copy(dec, dec->distance + 1, in[i++] + LZSS_MATCH_MIN);
+		if (err) {
+			return err;
+		}
+
+		dec->split_match = false;
+	}
+
+	while (i < in_len) {
+		if (dec->items == 0) {
+			dec->flags = in[i++];
+			dec->items = GROUP_ITEMS;
+			continue;
+		}
+
+		if (dec->flags & BIT(GROUP_ITEMS - dec->items)) {
+			if (i + 1 == in_len) {
+				dec->distance = in[i++];
+				dec->split_match = true;
+				dec->items--;
+				break;
+			}
+
+			err = match_copy(dec, in[i] + 1, in[i + 1] + LZSS_MATCH_MIN);
+			if (err) {
+				return err;
+			}
+
+			i += 2;
+		} else {
+			if (dec->out_len == dec->out_size) {
+				return -ENOSPC;
+			}
+
+			dec->out[dec->out_len++] = in[i++];
+		}
+
+		dec->items--;
+	}
+
+	return 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Small LZSS codec with a 256 byte window.
+ *
+ * The compressed data is a sequence of groups, each a flag byte followed by up to eight
+ * items. Bit n of the flag byte, from the least significant, is set if item n is a match
+ * and clear if it is a literal byte. A match is two bytes, the distance back into the
+ * output minus one and the length minus LZSS_MATCH_MIN. Neither side allocates memory,
+ * and the decoder takes its input in chunks of any size.
+ */
+
+#ifndef LZSS_H__
+#define LZSS_H__
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of the window, the largest distance of a match. */
+#define LZSS_WINDOW_SIZE 256
+/** Shortest match, shorter repeats are cheaper as literals. */
+#define LZSS_MATCH_MIN 3
+/** Longest match. */
+#define LZSS_MATCH_MAX (LZSS_MATCH_MIN + 255)
+
+/**
+ * @brief Compress a buffer.
+ *
+ * @param[in] in Data.
+ * @param[in] in_len Length of the data in bytes.
+ * @param[out] out Compressed data.
+ * @param[in] out_size Size of the output buffer in bytes.
+ *
+ * @return Length of the compressed data, or -ENOSPC if it does not fit in the output
+ *	   buffer.
+ */
+int lzss_compress(const uint8_t *in, size_t in_len, uint8_t *out, size_t out_size);
+
+/** @brief State of a streaming decoder. */
+struct lzss_decoder {
+	uint8_t *out;
+	size_t out_size;
+	size_t out_len;
+	/** Flag byte of the current group. */
+	uint8_t flags;
+	/** Items left in the current group. */
+	uint8_t items;
+	/** Distance byte of a match split between two chunks. */
+	uint8_t distance;
+	/** A match is split between two chunks. */
+	bool split_match;
+};
+
+/**
+ * @brief Start decoding.
+ *
+ * @param[out] dec Decoder.
+ * @param[out] out Buffer for the decompressed data, which is also the window.
+ * @param[in] out_size Size of the buffer in bytes.
+ */
+void lzss_decoder_init(struct lzss_decoder *dec, uint8_t *out, size_t out_size);
+
+/**
+ * @brief Decode the next chunk of compressed data.
+ *
+ * @param[in,out] dec Decoder.
+ * @param[in] in Chunk.
+ * @param[in] in_len Length of the chunk in bytes.
+ *
+ * @return 0 on success, -ENOSPC if the output buffer is full, -EINVAL if a match
+ *	   reaches before the start of the output.
+ */
+int lzss_decode(struct lzss_decoder *dec, const uint8_t *in, size_t in_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LZSS_H__ */
@@ -17,6 +17,15 @@
 #include <modem/modem_info.h>
 #include "json_payload.h"
 #include "settings_defs.h"
+#include "orientation.h"
+#include "calibration.h"
+#include "feedback.h"
+#include "impact_queue.h"
+#include "tap_pattern.h"
+#include "habit_batch.h"
+#include "event_queue.h"
+#include "simulation.h"
+#include "trace_replay.h"
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
 #include <zephyr/drivers/gpio.h>
@@ -46,8 +55,38 @@
 
 // AWS IoT Topics
 #define AWS_IOT_SHADOW_TOPIC_UPDATE_DELTA "$aws/things/%s/shadow/update/delta"
-#define HABIT_EVENT_TOPIC "habit-tracker-data/%s/events"
-struct pwm_dt_spec sBuzzer = PWM_DT_SPEC_GET(DT_ALIAS(buzzer_pwn));
+#define HABIT_EVENT_TOPIC "habit-tracker-data/" CONFIG_AWS_IOT_CLIENT_ID_STATIC "/events"
+#define HABIT_BATCH_TOPIC "habit-tracker-data/" CONFIG_AWS_IOT_CLIENT_ID_STATIC "/batches"
+
+/* Topics of habit messages, the kind of a message in the persistent event queue */
+enum habit_topic {
+	HABIT_TOPIC_EVENT,
+	HABIT_TOPIC_BATCH,
+};
+
+/* Habit topics are built at compile time, not for every message */
+static const struct aws_iot_topic_data habit_topics[] = {
+	[HABIT_TOPIC_EVENT] = {.str = HABIT_EVENT_TOPIC, .len = sizeof(HABIT_EVENT_TOPIC) - 1},
+	[HABIT_TOPIC_BATCH] = {.str = HABIT_BATCH_TOPIC, .len = sizeof(HABIT_BATCH_TOPIC) - 1},
+};
+
+/* Longest habit ID, the size of habit_id in data.options without the terminator */
+#define HABIT_ID_LEN_MAX (SIZEOF_FIELD(habit_data, habit_id) - 1)
+
+/* A single habit_data is encoded straight into this buffer and published from it */
+static uint8_t habit_tx_buf[habit_data_size];
+
+/* Every message that fails to publish must fit in a record of the event queue */
+#if defined(CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE)
+BUILD_ASSERT(CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE_MESSAGE_SIZE >= habit_data_size,
+	     "Event queue records are smaller than habit_data_size");
+#if defined(CONFIG_AWS_IOT_SAMPLE_HABIT_BATCH)
+BUILD_ASSERT(CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE_MESSAGE_SIZE >=
+	     CONFIG_AWS_IOT_SAMPLE_HABIT_BATCH_SIZE,
+	     "Event queue records are smaller than a habit batch");
+#endif
+#endif
+struct pwm_dt_spec sBuzzer = PWM_DT_SPEC_GET_OR(DT_ALIAS(buzzer_pwn), {0});
 
 
 typedef struct settings_data Settings_data; 
@@ -100,19 +139,18 @@ LOG_MODULE_REGISTER(dodd, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
 /* additional definitions */
 
 /* Sensor definitions */
-static const struct device *sensor = DEVICE_DT_GET(DT_NODELABEL(adxl362));
-static const enum sensor_channel channels[] = {
-	SENSOR_CHAN_ACCEL_X,
-	SENSOR_CHAN_ACCEL_Y,
-	SENSOR_CHAN_ACCEL_Z,
-};
-struct sensor_value accel[3];
+#define MG_TO_MS2(mg) ((mg) * SENSOR_G / 1000000000.0)
+
+/* NULL when the accelerometer is emulated, see CONFIG_EXTERNAL_SENSORS_EMUL */
+static const struct device *sensor = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(adxl362));
 char accelX[10];
 char accelY[10];
 char accelZ[10];
 
 /* counter variables */
 int32_t occurrence_count = 0;
+/* Taps of the current count, only accessed from the system work queue */
+static struct tap_pattern tap_sequence;
 bool counter_active = false;
 
 /* time variables */
@@ -135,44 +173,8 @@ static struct gpio_callback button_cb_data;
 // Side of the device for sending based on rotation
 int acctiveSide = 0;
 int newSide;
-// Real-time side
-int rt_side;
-
-double Xaccel[10] = {};
-double Yaccel[10] = {};
-double Zaccel[10] = {};
-
-double medianX;
-double medianY;
-double medianZ;
-
-/*Config for each side*/
-struct each_side {
-	double accelX;
-	double accelY;
-	double accelZ;
-};
-
-/*Normal vectors for each side*/
-struct each_side normal_vectors[12] = {
-	{-0.003696148, -0.069007951, -0.996817534}, // side 0
-	{0.879237385, -0.308156155, -0.361714449},  // side 1
-	{-0.024281719, -0.90438758, -0.422177015},  // side 2
-	{-0.884967095, -0.232578156, -0.400957651}, // side 3
-	{-0.553576905, 0.735285768, -0.389626839},  // side 4
-	{0.525613609, 0.741611336, -0.415332151},   // side 5
-	{-0.541858156, -0.691422294, 0.476691277},  // side 6
-	{0.475564405, -0.757096215, 0.442519528},   // side 7
-	{0.810239622, 0.211181093, 0.540259636},    // side 8
-	{-0.031841904, 0.852591043, 0.519405125},   // side 9
-	{-0.857683398, 0.311294211, 0.408629604},   // side 10
-	{0.005361934, -0.033163197, 0.995770246},   // side 11
-};
-
-/*help values to store double values to send to aws*/
-char median_values_X[10];
-char median_values_Y[10];
-char median_values_Z[10];
+/* Side n uses side_settings[n - 1] */
+BUILD_ASSERT(ORIENTATION_SIDES == MAX_SIDES + 1);
 
 /* Zephyr NET management event callback structures. */
 static struct net_mgmt_event_callback l4_cb;
@@ -183,235 +185,104 @@ static void shadow_update_work_fn(struct k_work *work);
 static void connect_work_fn(struct k_work *work);
 static void aws_iot_event_handler(const struct aws_iot_evt *const evt);
 static void counter_stop_fn(struct k_work *work);
+static void impact_count_fn(struct k_work *work);
+static void tap_pattern_fn(struct k_work *work);
 static void set_newSide_fn(struct k_work *work);
 static void start_timer_fn(struct k_work *work);
 static void stop_timer_fn(struct k_work *work);
-static void turn_led_off(struct k_work *work);
+static void event_replay_fn(struct k_work *work);
 static void check_position();
-static void create_message();
+static void create_message(const habit_data *message);
 
 /* Work items used to control some aspects of the sample. */
 static K_WORK_DELAYABLE_DEFINE(shadow_update_work, shadow_update_work_fn);
 static K_WORK_DELAYABLE_DEFINE(connect_work, connect_work_fn);
-static K_WORK_DELAYABLE_DEFINE(led_off_work, turn_led_off);
 static K_WORK_DELAYABLE_DEFINE(counter_stop, counter_stop_fn);
+static K_WORK_DEFINE(impact_count, impact_count_fn);
+static K_WORK_DELAYABLE_DEFINE(tap_pattern_work, tap_pattern_fn);
 static K_WORK_DELAYABLE_DEFINE(set_newSide, set_newSide_fn);
 static K_WORK_DELAYABLE_DEFINE(start_timer, start_timer_fn);
 static K_WORK_DELAYABLE_DEFINE(stop_timer, stop_timer_fn);
+static K_WORK_DELAYABLE_DEFINE(event_replay, event_replay_fn);
 
 /* Create thread for checking the position of the device */
 K_THREAD_STACK_DEFINE(stack_area, 2048);
 struct k_thread check_pos_data;
 
+/* Motion state reported by the accelerometer activity and inactivity triggers */
+static K_SEM_DEFINE(motion_sem, 0, 1);
+static atomic_t device_moving;
 
+/* Set between AWS_IOT_EVT_READY and AWS_IOT_EVT_DISCONNECTED */
+static atomic_t cloud_ready;
 
-/* Static functions */
-static void buzzer()
-{
-	int ret;
-	printk("Buzzer\n");
-	ret = pwm_set_dt(&sBuzzer, PWM_HZ(500), PWM_HZ(1000) / 2);
-  // pwm_capture_nsec(&sBuzzer, PWM_HZ(500), PWM_HZ(1000) / 2, 200);
-	//pwm_set_dt(&sBuzzer, PWM_HZ(1000), PWM_HZ(1000) / 2);
-}
-
-static int play_tone(int frequency, int duration, int volume)
-{
-	if (!pwm_is_ready_dt(&sBuzzer)) {
-		printk("Error: PWM device %s is not ready\n",
-		       sBuzzer.dev->name);
-		return -1;
-	}
-	
-	int division_factor = 32 - volume / 3;
-	if (volume > 95) {
-		division_factor = 1;
-	} else if (volume < 5) {
-		division_factor = 32;
-	}
-	uint32_t pwm_period_ns = NSEC_PER_SEC / frequency;
-	uint32_t pwm_duty_cycle_ns = pwm_period_ns / division_factor;
-	// Set the PWM period and duty cycle
-	if (pwm_set_dt(&sBuzzer, pwm_period_ns, pwm_duty_cycle_ns)) {
-        printk("Error: Failed to set PWM period and duty cycle\n");
-        return -2;
-    }
+/* Set once the position thread is created, on the first AWS_IOT_EVT_READY */
+static atomic_t position_thread_started;
 
-	// Play the tone for the specified duration
-	k_sleep(K_MSEC(duration));
 
-	// Turn off the PWM signal
-	if (pwm_set_dt(&sBuzzer, 0, 0)) {
-        printk("Error: Failed to turn off note\n");
-        return -3;
-    }
-
-	return 0;
-}
 
-static int config_received_sound(){
-	int ret;
-	ret = play_tone(1760, 100, 50);
-	
-	ret = play_tone(2637, 500, 50);
-
-	return ret;
-}
-
-static int count_sound() {
-	int ret;
-	ret = play_tone(1000, 100, 25);
-	return ret;
-}
-
-static int time_start_sound(){
-	int ret;
-	ret = play_tone(500, 50, 50);
-	ret = play_tone(600, 50, 50);
-	ret = play_tone(700, 50, 50);
-	ret = play_tone(800, 50, 50);
-	ret = play_tone(900, 50, 50);
-	ret = play_tone(1000, 50, 50);
-	return ret;
-}
-
-static int time_stop_sound(){
-	int ret;
-	ret = play_tone(1000, 50, 50);
-	ret = play_tone(900, 50, 50);
-	ret = play_tone(800, 50, 50);
-	ret = play_tone(700, 50, 50);
-	ret = play_tone(600, 50, 50);
-	ret = play_tone(500, 50, 50);
-	return ret;
-}
-
-static int32_t int64_to_int32(int64_t large_value)
-{
-	// scale down int64 to int32
-	return (int32_t)(large_value / 1000);
-}
-
-static bool encode_string(pb_ostream_t *stream, const pb_field_t *field, void *const *arg)
-{
-	// encode string so protobuff accept it
-	const char *str = (const char *)(*arg);
-	if (!pb_encode_tag_for_field(stream, field)) {
-		return false;
-	}
-	return pb_encode_string(stream, (uint8_t *)str, strlen(str));
-}
-
-static void turn_led_off(struct k_work *work)
-{
-	// turn led off in a work function
-	gpio_pin_set_dt(&led, 0);
-}
-
-static int compare(const void *a, const void *b)
-{
-	double *double_a = (double *)a;
-	double *double_b = (double *)b;
-	// Compare the doubles
-	if (&double_a < &double_b) {
-		return -1; // Return a negative value if a should appear before b
-	} else if (&double_a > &double_b) {
-		return 1; // Return a positive value if a should appear after b
-	} else {
-		return 0; // Return 0 if a and b are equal
-	}
-}
-
-/* Function to calculate median*/
-static double calculate_median(double accel[], int array_size)
+/* Static functions */
+static void button_pressed(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
 {
-	// sort list
-	qsort(accel, array_size, sizeof(int), compare);
-
-	// find median
-	if (array_size % 2 == 0) {
-		return (accel[array_size / 2 - 1] + accel[array_size / 2]) / 2.0;
+	// the button starts calibration, and a second press stores the sides captured so far
+	if (calibration_active()) {
+		calibration_stop();
+		// wake up the orientation thread so calibration finishes now
+		k_sem_give(&motion_sem);
 	} else {
-		return accel[array_size / 2];
+		calibration_start();
 	}
 }
 
-/*Calculate dot product of two vectors*/
-static double vector_dot_product(double vector1[], double vector2[])
-{
-	return vector1[0] * vector2[0] + vector1[1] * vector2[1] + vector1[2] * vector2[2];
-}
-
-/*Returns what side is up on the dodd*/
-static int find_what_side(struct each_side sides[], int number_of_sides)
-{
-
-	double median_vector[3] = {medianX, medianY, medianZ};
-
-	double delta = 2;
-
-	for (size_t i = 0; i < number_of_sides; i++) {
-
-		double normal_vector[3] = {sides[i].accelX, sides[i].accelY, sides[i].accelZ};
-
-		double normal_acc = vector_dot_product(normal_vector, median_vector);
-
-		if (normal_acc > 9.81 - delta) {
-			return i;
-		}
-	}
-
-	return -1; // error if valus are not in range
-}
-
-/*Use a median filter to remove noise from accel values*/
-static void sampling_filter(int number_of_samples, const struct device *dev, int32_t ms)
+FEEDBACK_PATTERN_DEFINE(config_received_sound,
+	{.frequency = 1760, .duration = 100, .volume = 50},
+	{.frequency = 2637, .duration = 500, .volume = 50});
+
+// the LED stays on for 200 ms after each counted impact
+FEEDBACK_PATTERN_DEFINE(count_sound,
+	{.frequency = 1000, .duration = 100, .volume = 25, .led = FEEDBACK_LED_ON},
+	{.frequency = 0, .duration = 100, .led = FEEDBACK_LED_OFF});
+
+// the LED stays on while the timer runs
+FEEDBACK_PATTERN_DEFINE(time_start_sound,
+	{.frequency = 500, .duration = 50, .volume = 50, .led = FEEDBACK_LED_ON},
+	{.frequency = 600, .duration = 50, .volume = 50},
+	{.frequency = 700, .duration = 50, .volume = 50},
+	{.frequency = 800, .duration = 50, .volume = 50},
+	{.frequency = 900, .duration = 50, .volume = 50},
+	{.frequency = 1000, .duration = 50, .volume = 50});
+
+// a falling pair of notes confirms that a count was taken back
+FEEDBACK_PATTERN_DEFINE(undo_sound,
+	{.frequency = 1000, .duration = 100, .volume = 25},
+	{.frequency = 500, .duration = 200, .volume = 25});
+
+FEEDBACK_PATTERN_DEFINE(time_stop_sound,
+	{.frequency = 1000, .duration = 50, .volume = 50, .led = FEEDBACK_LED_OFF},
+	{.frequency = 900, .duration = 50, .volume = 50},
+	{.frequency = 800, .duration = 50, .volume = 50},
+	{.frequency = 700, .duration = 50, .volume = 50},
+	{.frequency = 600, .duration = 50, .volume = 50},
+	{.frequency = 500, .duration = 50, .volume = 50});
+
+static int get_side(const struct device *dev, uint8_t *confidence)
 {
 	int ret;
+	struct ext_sensor_accel_raw sample;
 
-	int count = 0;
-
-	while (count < number_of_samples) {
-		ret = sensor_sample_fetch(dev);
-		if (ret < 0) {
-			printk("sensor_sample_fetch() failed: %d\n", ret);
-		}
-		for (size_t i = 0; i < ARRAY_SIZE(channels); i++) {
-			ret = sensor_channel_get(dev, channels[i], &accel[i]);
-			if (ret < 0) {
-				printk("sensor_channel_get(%c) failed: %d\n", 'X' + i, ret);
-			}
-		}
-
-		Xaccel[count] = sensor_value_to_double(&accel[0]);
-		Yaccel[count] = sensor_value_to_double(&accel[1]);
-		Zaccel[count] = sensor_value_to_double(&accel[2]);
-
-		count++;
-		k_msleep(ms);
-	}
-
-	medianX = calculate_median(Xaccel, number_of_samples);
-	medianY = calculate_median(Yaccel, number_of_samples);
-	medianZ = calculate_median(Zaccel, number_of_samples);
-
-	snprintf(median_values_X, sizeof(median_values_X), "%f", medianX);
-	snprintf(median_values_Y, sizeof(median_values_Y), "%f", medianY);
-	snprintf(median_values_Z, sizeof(median_values_Z), "%f", medianZ);
-}
-
-static int get_side(const struct device *dev)
-{
 	//	Check if device is ready, if not return 0
-	if (!device_is_ready(dev)) {
+	if (dev != NULL && !device_is_ready(dev)) {
 		printk("sensor: device not ready.\n");
 		return 0;
 	}
-	// apply median filter to accel values
-	sampling_filter(10, dev, 100);
-	// find what side is up
-	rt_side = find_what_side(normal_vectors, 12);
-	return rt_side;
+	// samples are read from the accelerometer FIFO stream, the thread sleeps until they arrive
+	ret = ext_sensors_accelerometer_stream_read(&sample, K_FOREVER);
+	if (ret < 0) {
+		printk("ext_sensors_accelerometer_stream_read() failed: %d\n", ret);
+		return -1;
+	}
+	// apply median filter to accel values and find what side is up
+	return orientation_update(&sample, confidence);
 }
 
 static int app_topics_subscribe(void)
@@ -500,6 +371,9 @@ static void shadow_update_work_fn(struct k_work *work)
 		cJSON *side_item = cJSON_CreateObject();
 		cJSON_AddStringToObject(side_item, "id", side_settings[i]->id);
 		cJSON_AddStringToObject(side_item, "type", side_settings[i]->type);
+		if (side_settings[i]->handle) {
+			cJSON_AddNumberToObject(side_item, "handle", side_settings[i]->handle);
+		}
 		cJSON_AddItemToObject(reported, item_number_as_string, side_item);
 		
 	}
@@ -531,6 +405,7 @@ static void shadow_update_work_fn(struct k_work *work)
 	LOG_INF("Publishing message: %s to AWS IoT shadow", message);
 
 	err = aws_iot_send(&tx_data);
+	simulation_count(err ? SIMULATION_PUBLISH_FAILED : SIMULATION_PUBLISH);
 	if (err) {
 		LOG_ERR("aws_iot_send, error: %d", err);
 		FATAL_ERROR();
@@ -540,17 +415,120 @@ static void shadow_update_work_fn(struct k_work *work)
 	cJSON_Delete(root);
 }
 
+/* Every tap is counted as it arrives, a recognised pattern only acts on the count once
+ * its sequence is complete. Counts are applied optimistically and reverted once the
+ * pattern resolves: both taps of an undo double tap play the count cue first, and the
+ * undo cue follows when they are taken back.
+ */
+static void apply_tap_pattern(enum tap_pattern_type type)
+{
+	if (type == TAP_PATTERN_NONE) {
+		return;
+	}
+
+	LOG_INF("Recognised %s", tap_pattern_name(type));
+
+	if (IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_TAP_UNDO) && type == TAP_PATTERN_DOUBLE) {
+		// take back the double tap itself and the count before it
+		occurrence_count = MAX(occurrence_count - 3, 0);
+		feedback_play(&undo_sound);
+	}
+}
+
+static void tap_pattern_fn(struct k_work *work)
+{
+	apply_tap_pattern(tap_pattern_check(&tap_sequence, k_uptime_get()));
+}
+
+/* Consumer of the impact queue, runs on the system work queue like counter_stop_fn() so
+ * occurrence_count is only touched from there.
+ */
+static int count_impacts(void)
+{
+	struct impact_record impact;
+	uint32_t dropped;
+	int counted = 0;
+
+	while (impact_queue_get(&impact) == 0) {
+		LOG_DBG("Impact detected: %u.%02u g at %lld ms", impact.magnitude / 1000,
+			(impact.magnitude % 1000) / 10, impact.timestamp);
+		apply_tap_pattern(tap_pattern_tap(&tap_sequence, impact.timestamp));
+		occurrence_count++;
+		counted++;
+		simulation_count(SIMULATION_IMPACT);
+	}
+
+	if (counted) {
+		k_work_reschedule(&tap_pattern_work,
+				  K_TIMEOUT_ABS_MS(tap_pattern_deadline(&tap_sequence)));
+	}
+
+	// impacts that did not fit in the queue are still counted, without their timestamp
+	// they cannot be part of a tap pattern
+	dropped = impact_queue_overflow_take();
+	if (dropped) {
+		LOG_WRN("%u impacts counted without a record", dropped);
+	}
+
+	occurrence_count += dropped;
+
+	return counted + dropped;
+}
+
+static void impact_count_fn(struct k_work *work)
+{
+	if (count_impacts() == 0) {
+		return;
+	}
+
+	// count and rescedule counter stop with 5 secound delay
+	k_work_reschedule(&counter_stop, K_SECONDS(5));
+	feedback_play(&count_sound);
+}
+
+/* Events go into the current batch, and are published on their own only when they
+ * cannot be batched.
+ */
+static void submit_habit_event(const struct habit_event *event)
+{
+	habit_data message = habit_data_init_zero;
+
+	if (IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_HABIT_BATCH) && habit_batch_add(event) == 0) {
+		return;
+	}
+
+	// millisecond timestamp, and the start of a session as a delta to it
+	message.timestamp_ms = event->timestamp_ms;
+	message.data = event->data;
+	if (event->start_ms) {
+		message.start_delta_ms = event->start_ms - event->timestamp_ms;
+	}
+	// the handle from the shadow stands in for the habit ID string
+	if (event->habit_handle) {
+		message.habit_handle = event->habit_handle;
+	} else {
+		strncpy(message.habit_id, event->habit_id, HABIT_ID_LEN_MAX);
+	}
+	create_message(&message);
+}
+
 static void counter_stop_fn(struct k_work *work)
 {
+	// impacts before the count stopped are part of this count
+	count_impacts();
+	k_work_cancel_delayable(&tap_pattern_work);
+	apply_tap_pattern(tap_pattern_flush(&tap_sequence));
+
 	// creates message with on count stop
 	if (occurrence_count != 0) {
-		habit_data message = habit_data_init_zero;
 		date_time_now(&unix_time);
-		message.device_timestamp = int64_to_int32(unix_time);
-		message.data = occurrence_count;
-		message.habit_id.arg = side_settings[acctiveSide - 1]->id;
-		message.habit_id.funcs.encode = &encode_string;
-		create_message(message);
+		struct habit_event event = {
+			.timestamp_ms = unix_time,
+			.data = occurrence_count,
+			.habit_id = side_settings[acctiveSide - 1]->id,
+			.habit_handle = side_settings[acctiveSide - 1]->handle,
+		};
+		submit_habit_event(&event);
 	}
 	occurrence_count = 0;
 }
@@ -560,17 +538,25 @@ static void impact_handler(const struct ext_sensor_evt *const evt)
 	switch (evt->type) {
 		// when accelerometer impact trigger is detected
 		case EXT_SENSOR_EVT_ACCELEROMETER_IMPACT_TRIGGER:
-			// if counter is active run the impact handler
+			// if counter is active queue the impact for the counter, never waiting here
 			if (counter_active) {
-				printf("Impact detected: %6.2f g\n", evt->value);
-				// cancel counter stop, count one, and rescedule counter stop with 5 secound delay
-				k_work_cancel_delayable(&counter_stop);
-				occurrence_count ++;
-				gpio_pin_set_dt(&led, 1);
-				k_work_schedule(&led_off_work, K_SECONDS(0.2));
-				k_work_reschedule(&counter_stop, K_SECONDS(5));
-				count_sound();
+				struct impact_record impact = {
+					.timestamp = evt->timestamp,
+					.magnitude = EXT_SENSOR_EVT_IMPACT_MG(evt),
+				};
+
+				impact_queue_put(&impact);
+				k_work_submit(&impact_count);
 			}
+			break;
+		// wake up the position thread when the device is moved
+		case EXT_SENSOR_EVT_ACCELEROMETER_ACT_TRIGGER:
+			atomic_set(&device_moving, true);
+			k_sem_give(&motion_sem);
+			break;
+		case EXT_SENSOR_EVT_ACCELEROMETER_INACT_TRIGGER:
+			atomic_set(&device_moving, false);
+			break;
 		default:
 				break;
 	}
@@ -583,8 +569,7 @@ static void start_timer_fn(struct k_work *work)
 	if (ret == 0) {
 		printk("Starting timer\n");
 		start_time = unix_time;
-		gpio_pin_set_dt(&led, 1);
-		time_start_sound();
+		feedback_play(&time_start_sound);
 	} else {
 		LOG_ERR("Error getting time");
 	}
@@ -597,52 +582,158 @@ static void stop_timer_fn(struct k_work *work)
 	if (ret == 0) {
 		printk("Stopping timer\n");
 		//create message
-		habit_data message = habit_data_init_zero;
-		message.device_timestamp = int64_to_int32(unix_time);
-		message.habit_id.arg = side_settings[acctiveSide - 1]->id;
-		message.habit_id.funcs.encode = &encode_string;
-		message.start_timestamp = int64_to_int32(start_time);
-		message.stop_timestamp = int64_to_int32(unix_time);
-		create_message(message);
-		k_work_schedule(&led_off_work, K_NO_WAIT);
-		time_stop_sound();
+		struct habit_event event = {
+			.timestamp_ms = unix_time,
+			.start_ms = start_time,
+			.habit_id = side_settings[acctiveSide - 1]->id,
+			.habit_handle = side_settings[acctiveSide - 1]->handle,
+		};
+		submit_habit_event(&event);
+		feedback_play(&time_stop_sound);
 	} else {
 		LOG_ERR("Error getting time");
 	}
 }
 
+/* Side 0 has no habit, side n uses side_settings[n - 1] */
+static bool side_type_is(int side, const char *type)
+{
+	if (side < 1 || side > MAX_SIDES) {
+		return false;
+	}
+	return strcmp(side_settings[side - 1]->type, type) == 0;
+}
+
 static void set_newSide_fn(struct k_work *work)
 {
 	acctiveSide = newSide;
 	// if the new side is count start the count
-	if (strcmp(side_settings[acctiveSide - 1]->type, "COUNT") == 0) {
+	if (side_type_is(acctiveSide, "COUNT")) {
 		counter_active = true;
 	}
 	// if the new side is time start the timer
-	if (strcmp(side_settings[acctiveSide - 1]->type, "TIME") == 0) {
+	if (side_type_is(acctiveSide, "TIME")) {
 		k_work_reschedule(&start_timer, K_NO_WAIT);
 	}
 }
 
+static int motion_detection_init(void)
+{
+	int err;
+
+	err = ext_sensors_accelerometer_threshold_set(
+		MG_TO_MS2(CONFIG_AWS_IOT_SAMPLE_ORIENTATION_ACTIVITY_THRESHOLD_MG), true);
+	if (err) {
+		return err;
+	}
+
+	err = ext_sensors_accelerometer_threshold_set(
+		MG_TO_MS2(CONFIG_AWS_IOT_SAMPLE_ORIENTATION_INACTIVITY_THRESHOLD_MG), false);
+	if (err) {
+		return err;
+	}
+
+	err = ext_sensors_inactivity_timeout_set(
+		CONFIG_AWS_IOT_SAMPLE_ORIENTATION_INACTIVITY_TIMEOUT_MS / 1000.0);
+	if (err) {
+		return err;
+	}
+
+	return ext_sensors_accelerometer_trigger_callback_set(true);
+}
+
+static void check_side_change(void)
+{
+	uint8_t confidence;
+	int side = get_side(sensor, &confidence);
+	// skip rejected or uncertain windows and windows where nothing has changed
+	// sides do not start habits while the enclosure is being calibrated
+	if (side == -1 || side == newSide || calibration_active() ||
+	    confidence < CONFIG_AWS_IOT_SAMPLE_ORIENTATION_MIN_CONFIDENCE) {
+		return;
+	}
+	// if the prew side is count stop the count
+	if (side_type_is(acctiveSide, "COUNT")) {
+		counter_active = false;
+		k_work_reschedule(&counter_stop, K_NO_WAIT);
+	}
+	// if the prew side is time stop the timer
+	if (side_type_is(acctiveSide, "TIME")) {
+		k_work_reschedule(&stop_timer, K_NO_WAIT);
+	}
+	// set the new side
+	newSide = side;
+	simulation_count(SIMULATION_SIDE_CHANGE);
+	k_work_reschedule(&set_newSide, K_NO_WAIT);
+}
+
+static void calibrate_side(void)
+{
+	int ret = calibration_update();
+
+	if (ret == -EAGAIN) {
+		LOG_WRN("Calibration skipped, the device is not resting on a side");
+	} else if (ret == -EALREADY) {
+		LOG_WRN("Calibration: side already captured, present the next side");
+		feedback_play(&undo_sound);
+	} else if (ret < 0) {
+		LOG_ERR("Failed to store calibration, error: %d", ret);
+	} else if (ret > 0) {
+		LOG_INF("Calibration: %d sides left", ret);
+		feedback_play(&count_sound);
+	} else {
+		feedback_play(&config_received_sound);
+	}
+}
+
 static void check_position() 
 {
 	/* function to check side, runs in separate tread */
+	int64_t sampling_time = 0;
+	orientation_init();
+
+	int err = motion_detection_init();
+	if (err) {
+		LOG_ERR("Failed to set up motion detection, error: %d", err);
+		return;
+	}
+
+	// the side is unknown at boot, sample once before waiting for motion
+	k_sem_give(&motion_sem);
+
 	while (true) {
-		newSide = get_side(sensor);
-		// if side is changed and the new side is not -1
-		if (newSide != -1 && acctiveSide != newSide) {
-			// if the prew side is count stop the count
-			if (strcmp(side_settings[acctiveSide - 1]->type, "COUNT") == 0) {
-				counter_active = false;
-				k_work_reschedule(&counter_stop, K_NO_WAIT);
-			}
-			// if the prew side is time stop the timer
-			if (strcmp(side_settings[acctiveSide - 1]->type, "TIME") == 0) {
-				k_work_reschedule(&stop_timer, K_NO_WAIT);
-			}
-			// set the new side
-			k_work_reschedule(&set_newSide, K_NO_WAIT);
+		// sleep until the accelerometer reports activity
+		k_sem_take(&motion_sem, K_FOREVER);
+
+		int64_t session_start = k_uptime_get();
+
+		orientation_filter_reset();
+
+		err = ext_sensors_accelerometer_stream_start();
+		if (err) {
+			LOG_ERR("Failed to start accelerometer stream, error: %d", err);
+			return;
+		}
+
+		// sample until inactivity is reported, and until the gravity estimate has settled
+		for (int n = 0; n < ORIENTATION_SETTLE_SAMPLES || atomic_get(&device_moving); n++) {
+			check_side_change();
+		}
+
+		err = ext_sensors_accelerometer_stream_stop();
+		if (err) {
+			LOG_ERR("Failed to stop accelerometer stream, error: %d", err);
 		}
+
+		// the device is at rest, capture the side it rests on
+		if (calibration_active()) {
+			calibrate_side();
+		}
+
+		sampling_time += k_uptime_get() - session_start;
+		LOG_INF("Accelerometer sampled %lld of %lld ms, %lld%% less than continuous sampling",
+			sampling_time, k_uptime_get(),
+			100 - sampling_time * 100 / MAX(k_uptime_get(), 1));
 	}
 }
 
@@ -656,6 +747,7 @@ int send_shadow_update_msg(char *msg){
 	tx_data.len = strlen(msg);
 
 	int err = aws_iot_send(&tx_data);
+	simulation_count(err ? SIMULATION_PUBLISH_FAILED : SIMULATION_PUBLISH);
 	if (err) {
 		LOG_ERR("aws_iot_send, error: %d", err);
 		return err;
@@ -670,10 +762,12 @@ void on_first_run(void)
 	for (int i = 0; i < MAX_SIDES; i++) {
 		side_settings[i]->id = "";
 		side_settings[i]->type = "";
+		side_settings[i]->handle = 0;
 		save_side_config(i, *side_settings[i]);
 	}
 	config_version = 0;
 	settings_save_one("config_version", 0, sizeof(0));
+	simulation_count(SIMULATION_SETTINGS_WRITE);
 	// Create CJSON object with "state": {"reported": {null}}
 	cJSON *root = cJSON_CreateObject();
 	cJSON *state = cJSON_CreateObject();
@@ -708,6 +802,7 @@ static void connect_work_fn(struct k_work *work)
 static void on_aws_iot_evt_connected(const struct aws_iot_evt *const evt)
 {
 	(void)k_work_cancel_delayable(&connect_work);
+	simulation_count(SIMULATION_CONNECT);
 
 	/* If persistent session is enabled, the AWS IoT library will not subscribe to any topics.
 	 * Topics from the last session will be used.
@@ -781,15 +876,24 @@ void save_side_config(int side, Settings_data side_settings){
 	
 	sprintf(name, "side_%d/id", side);
 	int ret = settings_save_one(name, &side_settings.id, sizeof(side_settings.id));
+	simulation_count(SIMULATION_SETTINGS_WRITE);
 	if (ret) {
 		printk("Error saving side_%d/id: %d\n", side, ret);
 	}
 
 	sprintf(name, "side_%d/type", side);
 	ret = settings_save_one(name, &side_settings.type, sizeof(side_settings.type));
+	simulation_count(SIMULATION_SETTINGS_WRITE);
 	if (ret) {
 		printk("Error saving side_%d/type: %d\n", side, ret);
 	} 
+
+	sprintf(name, "side_%d/handle", side);
+	ret = settings_save_one(name, &side_settings.handle, sizeof(side_settings.handle));
+	simulation_count(SIMULATION_SETTINGS_WRITE);
+	if (ret) {
+		printk("Error saving side_%d/handle: %d\n", side, ret);
+	}
 	printk("Saved side_%d/id: %s\n", side, side_settings.id);
 	printk("Saved side_%d/type: %s\n", side, side_settings.type);
 }
@@ -813,6 +917,11 @@ static int start_settings_subsystem()
 		printk("Error registering settings for config_version: %d\n", err);
 		return err;
 		}
+	err = calibration_init();
+	if (err) {
+		printk("Error registering settings for normals: %d\n", err);
+		return err;
+	}
 	err = settings_load();
 	if (err) {
 		printk("Error loading settings: %d\n", err);
@@ -852,13 +961,26 @@ static void parse_config_json(const char *json){
     if (state != NULL) {
         // Iterate over each side config in state
         for (cJSON *side_config = state->child; side_config != NULL; side_config = side_config->next) {
+            // calibration of the enclosure is requested with "calibrate": true
+            if (strcmp(side_config->string, "calibrate") == 0) {
+                if (cJSON_IsTrue(side_config)) {
+                    calibration_start();
+                }
+                continue;
+            }
             // Get side number
             int side = atoi(side_config->string);
+            if (side < 0 || side >= MAX_SIDES) {
+                printk("Ignoring config of unknown side %d\n", side);
+                continue;
+            }
             // Get id and type
             cJSON *id = cJSON_GetObjectItem(side_config, "id");
             cJSON *type = cJSON_GetObjectItem(side_config, "type");
+            cJSON *handle = cJSON_GetObjectItem(side_config, "handle");
 
-            if (id != NULL && cJSON_IsString(id)) {
+            if (id != NULL && cJSON_IsString(id) &&
+                strlen(id->valuestring) <= HABIT_ID_LEN_MAX) {
 				side_settings[side]->id = malloc(strlen(id->valuestring) + 1);
 				if (side_settings[side]->id == NULL) {
 					printk("Failed to allocate memory for id\n");
@@ -866,6 +988,15 @@ static void parse_config_json(const char *json){
 				}
 				strcpy(side_settings[side]->id, id->valuestring);
 
+				// a handle belongs to the ID it was assigned with, a new ID without
+				// one is sent as a string
+				if (cJSON_IsNumber(handle) && handle->valuedouble >= 1 &&
+				    handle->valuedouble <= UINT32_MAX) {
+					side_settings[side]->handle = (uint32_t)handle->valuedouble;
+				} else {
+					side_settings[side]->handle = 0;
+				}
+
 				if (type != NULL && cJSON_IsString(type)) {
                 if (strcmp(type->valuestring, "TIME") == 0) {
                     side_settings[side]->type = "TIME";
@@ -885,6 +1016,7 @@ static void parse_config_json(const char *json){
     }
 	config_version = version->valueint;
 	settings_save_one("config_version", &config_version, sizeof(config_version));;
+	simulation_count(SIMULATION_SETTINGS_WRITE);
 
 	// Duplicate contents of state to reported
 	cJSON *reported = cJSON_Duplicate(state, 1);
@@ -921,13 +1053,24 @@ static void aws_iot_event_handler(const struct aws_iot_evt *const evt)
 		break;
 	case AWS_IOT_EVT_READY:
 		LOG_INF("AWS_IOT_EVT_READY");
+		atomic_set(&cloud_ready, true);
+		// publish what was queued while offline, in order
+		if (IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE)) {
+			k_work_reschedule(&event_replay, K_NO_WAIT);
+		}
 		if (first_run){
 			on_first_run();
 		}
-		/* on iot ready create a new thred for start to check the position */
-		k_thread_create(&check_pos_data, stack_area, K_THREAD_STACK_SIZEOF(stack_area),
-				check_position, NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO,
-				0, K_NO_WAIT);
+		/* the position thread is created on the first ready event, a reconnect only
+		 * wakes it up to check the side again
+		 */
+		if (atomic_cas(&position_thread_started, false, true)) {
+			k_thread_create(&check_pos_data, stack_area,
+					K_THREAD_STACK_SIZEOF(stack_area), check_position, NULL,
+					NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+		} else {
+			k_sem_give(&motion_sem);
+		}
 		/* set button pressed as buttons funcion */
 		// gpio_init_callback(&button_cb_data, create_message, BIT(button.pin));
 		// gpio_add_callback(button.port, &button_cb_data);
@@ -935,6 +1078,7 @@ static void aws_iot_event_handler(const struct aws_iot_evt *const evt)
 		break;
 	case AWS_IOT_EVT_DISCONNECTED:
 		LOG_INF("AWS_IOT_EVT_DISCONNECTED");
+		atomic_set(&cloud_ready, false);
 		on_aws_iot_evt_disconnected();
 		break;
 	case AWS_IOT_EVT_DATA_RECEIVED:
@@ -945,7 +1089,7 @@ static void aws_iot_event_handler(const struct aws_iot_evt *const evt)
 		snprintf(delta_topic, sizeof(delta_topic), AWS_IOT_SHADOW_TOPIC_UPDATE_DELTA, CONFIG_AWS_IOT_CLIENT_ID_STATIC);
 		if (strncmp(evt->data.msg.topic.str, delta_topic, evt->data.msg.topic.len) == 0) {
 			printk("Received delta message, parsing config\n");
-			config_received_sound();
+			feedback_play(&config_received_sound);
 			parse_config_json(evt->data.msg.ptr);
 		}  else {
 			printk("Received message on unexpected topic\n");
@@ -1026,7 +1170,6 @@ static int init_led()
 		return 0;
 	}
 	return ret;
-	k_work_schedule(&led_off_work, K_NO_WAIT);
 }
 
 static int init_button()
@@ -1048,41 +1191,95 @@ static int init_button()
 	return ret;
 }
 
-static void create_message(habit_data message)
+static int publish_habit_message(uint8_t topic, const uint8_t *buf, size_t len)
 {
-	//define topic based on the thing
-	char event_topic[128];  
-	snprintf(event_topic, sizeof(event_topic), HABIT_EVENT_TOPIC, CONFIG_AWS_IOT_CLIENT_ID_STATIC);
-	struct aws_iot_topic_data myTopic = {
-					.str = event_topic,
-					.len = strlen(event_topic),
-	};
-	// Create a buffer to hold the serialized data
-	uint8_t buffer[128];
-	pb_ostream_t stream = pb_ostream_from_buffer(buffer, sizeof(buffer));
-
-	// Encode the message
-	bool status = pb_encode(&stream, habit_data_fields, &message);
-	if (!status) {
-			printf("Encoding failed: %s\n", PB_GET_ERROR(&stream));
-			return;
-	}
-	
-	printf("send protobuff message \n");
 	struct aws_iot_data data = {
 		.qos = MQTT_QOS_0_AT_MOST_ONCE,
-		.topic = myTopic,
-		.ptr = buffer,
-		.len = stream.bytes_written,
+		.topic = habit_topics[topic == HABIT_TOPIC_BATCH ? HABIT_TOPIC_BATCH :
+							       HABIT_TOPIC_EVENT],
+		.ptr = (void *)buf,
+		.len = len,
 	};
 
 	int err = aws_iot_send(&data);
+	simulation_count(err ? SIMULATION_PUBLISH_FAILED : SIMULATION_PUBLISH);
 	if (err) {
 		LOG_ERR("aws_iot_send, error: %d", err);
-		FATAL_ERROR();
+	}
+
+	return err;
+}
+
+/* Messages that cannot be published are kept in flash. While older messages wait in the
+ * queue new ones are queued behind them, so they are published in order.
+ *
+ * Returns 0 once the message is published or queued. An error is returned only if it is
+ * neither, always the case for a failed publish without the event queue; a batch is then
+ * kept by habit_batch and sent again later, while a single event is dropped.
+ */
+static int send_habit_message(uint8_t topic, const uint8_t *buf, size_t len)
+{
+	int err;
+
+	if (!IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE)) {
+		return publish_habit_message(topic, buf, len);
+	}
+
+	bool queued_behind = event_queue_pending() > 0;
+
+	if (!queued_behind && publish_habit_message(topic, buf, len) == 0) {
+		return 0;
+	}
+
+	err = event_queue_append(topic, buf, len);
+	if (err) {
+		LOG_ERR("Failed to queue message, error: %d", err);
+		return err;
+	}
+
+	if (atomic_get(&cloud_ready)) {
+		k_work_reschedule(&event_replay, queued_behind ? K_NO_WAIT :
+				  K_SECONDS(CONFIG_AWS_IOT_SAMPLE_CONNECTION_RETRY_TIMEOUT_SECONDS));
+	}
+
+	return 0;
+}
+
+static void event_replay_fn(struct k_work *work)
+{
+	int ret = event_queue_replay(publish_habit_message);
+
+	if (ret > 0) {
+		LOG_INF("Published %d queued messages", ret);
+	} else if (ret < 0) {
+		LOG_WRN("Replay stopped, error: %d, %u messages pending", ret,
+			event_queue_pending());
+	}
+}
+
+static void create_message(const habit_data *message)
+{
+	// habit_data has a fixed maximum size, so encoding into the TX buffer cannot overflow
+	pb_ostream_t stream = pb_ostream_from_buffer(habit_tx_buf, sizeof(habit_tx_buf));
+
+	// Encode the message
+	bool status = pb_encode(&stream, habit_data_fields, message);
+	if (!status) {
+		LOG_ERR("Encoding failed: %s", PB_GET_ERROR(&stream));
 		return;
 	}
-	return;
+
+	LOG_DBG("Sending habit_data of %zu bytes", stream.bytes_written);
+	// the message is lost only if it can neither be sent nor queued
+	int err = send_habit_message(HABIT_TOPIC_EVENT, habit_tx_buf, stream.bytes_written);
+	if (err) {
+		LOG_ERR("Habit event dropped, error: %d", err);
+	}
+}
+
+static int send_habit_batch(const uint8_t *buf, size_t len)
+{
+	return send_habit_message(HABIT_TOPIC_BATCH, buf, len);
 }
 
 
@@ -1090,11 +1287,27 @@ int main(void)
 {
 	int ret;
 
+	if (IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_ORIENTATION_TRACE_REPLAY)) {
+		trace_replay_run();
+	}
+
 	// initialize led function
 	ret = init_led();
+	// taps within the refractory window are one impact, so a shorter gap allows no pattern
+#if defined(CONFIG_EXTERNAL_SENSORS_IMPACT_DETECTION)
+	BUILD_ASSERT(CONFIG_AWS_IOT_SAMPLE_TAP_GAP_MS > CONFIG_EXTERNAL_SENSORS_IMPACT_REFRACTORY_MS,
+		     "The tap gap must be longer than the impact refractory window");
+#endif
+	tap_pattern_init(&tap_sequence, CONFIG_AWS_IOT_SAMPLE_TAP_GAP_MS);
+	// habit events are published in batches, see CONFIG_AWS_IOT_SAMPLE_HABIT_BATCH
+	if (IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_HABIT_BATCH)) {
+		habit_batch_init(send_habit_batch);
+	}
+	// play sounds and LED patterns in the background
+	ret = feedback_init(&sBuzzer, &led);
 	// initialize button function
 	ret = init_button();
-	gpio_init_callback(&button_cb_data, buzzer, BIT(button.pin));
+	gpio_init_callback(&button_cb_data, button_pressed, BIT(button.pin));
 	gpio_add_callback(button.port, &button_cb_data);
 	printk("Set up button at %s pin %d\n", button.port->name, button.pin);
 	ret = ext_sensors_init(impact_handler);
@@ -1102,6 +1315,8 @@ int main(void)
 		printf("Error initializing sensors: %d\n", ret);
 		return ret;
 	}
+	// log statistics of an accelerated-time run, does nothing on the device
+	simulation_start();
 
 	int err;
 	err = start_settings_subsystem();
@@ -1111,6 +1326,14 @@ int main(void)
 		return err;
 	}
 
+	// habit messages that could not be published before a reboot are still queued
+	if (IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_EVENT_QUEUE)) {
+		err = event_queue_init();
+		if (err) {
+			LOG_ERR("Error starting event queue: %d", err);
+		}
+	}
+
 	ret = ext_sensors_init(impact_handler);
 	if (ret) {
 			printf("Error initializing sensors: %d\n", ret);
@@ -1121,6 +1344,7 @@ int main(void)
 	for (int i = 0; i < MAX_SIDES; i++) {
 		printk("Side %d id: %s\n", i, side_settings[i]->id);
 		printk("Side %d type: %s\n", i, side_settings[i]->type);
+		printk("Side %d handle: %u\n", i, side_settings[i]->handle);
 	}
 
 	// start the aws iot sample
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "calibration.h"
+#include "orientation.h"
+#include "simulation.h"
+
+LOG_MODULE_REGISTER(calibration, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+#define ALL_SIDES_MASK BIT_MASK(ORIENTATION_SIDES)
+
+/* Cosine of the angle below which a capture is taken to be of an already captured side,
+ * well below the angle between neighbouring sides of the supported enclosures.
+ */
+#define SAME_SIDE_COS 0.94f
+
+BUILD_ASSERT(ORIENTATION_SIDES <= 32, "Captured sides do not fit in the mask");
+
+static atomic_t active;
+static atomic_t stop_requested;
+
+/* Only accessed from the orientation thread */
+static struct side_normal captured[ORIENTATION_SIDES];
+static uint32_t captured_mask;
+
+static int normal_settings_set(const char *name, size_t len, settings_read_cb read_cb,
+			       void *cb_arg)
+{
+	struct side_normal normal;
+	char *end;
+	long side;
+	int rc;
+
+	side = strtol(name, &end, 10);
+	if (end == name || *end != '\0' || side < 0 || side >= ORIENTATION_SIDES) {
+		return -ENOENT;
+	}
+
+	if (len != sizeof(normal)) {
+		return -EINVAL;
+	}
+
+	rc = read_cb(cb_arg, &normal, sizeof(normal));
+	if (rc < 0) {
+		return rc;
+	}
+
+	return orientation_normal_set(side, &normal);
+}
+
+static struct settings_handler normal_conf = {
+	.name = "normal",
+	.h_set = normal_settings_set,
+};
+
+int calibration_init(void)
+{
+	return settings_register(&normal_conf);
+}
+
+void calibration_start(void)
+{
+	atomic_set(&stop_requested, false);
+	atomic_set(&active, true);
+}
+
+void calibration_stop(void)
+{
+	atomic_set(&stop_requested, true);
+}
+
+bool calibration_active(void)
+{
+	return atomic_get(&active);
+}
+
+static bool side_captured_before(const struct side_normal *normal)
+{
+	for (int side = 0; side < ORIENTATION_SIDES; side++) {
+		if (!(captured_mask & BIT(side))) {
+			continue;
+		}
+
+		float dot = (float)normal->x * captured[side].x +
+			    (float)normal->y * captured[side].y +
+			    (float)normal->z * captured[side].z;
+
+		if (dot > SAME_SIDE_COS * INT16_MAX * INT16_MAX) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Sides are captured in order, the classification by the current normals is not used
+ * since those are what calibration corrects. Two sides could map to the same index.
+ */
+static int capture(void)
+{
+	struct side_normal normal;
+	int16_t gravity[3];
+	uint8_t confidence;
+	float magnitude;
+	int side;
+
+	side = orientation_gravity_get(gravity, &confidence);
+	if (side < 0 || confidence == 0) {
+		return -EAGAIN;
+	}
+
+	/* Not on the hot path, the normal is scaled to unit length in floating point. */
+	magnitude = sqrtf((float)gravity[0] * gravity[0] + (float)gravity[1] * gravity[1] +
+			  (float)gravity[2] * gravity[2]);
+
+	normal.x = gravity[0] * INT16_MAX / magnitude;
+	normal.y = gravity[1] * INT16_MAX / magnitude;
+	normal.z = gravity[2] * INT16_MAX / magnitude;
+
+	if (side_captured_before(&normal)) {
+		return -EALREADY;
+	}
+
+	side = __builtin_ctz(~captured_mask);
+	captured[side] = normal;
+	captured_mask |= BIT(side);
+
+	LOG_INF("Captured side %d: %d %d %d, confidence %d%%", side, captured[side].x,
+		captured[side].y, captured[side].z, confidence);
+
+	return 0;
+}
+
+static int finish(void)
+{
+	char name[16];
+	int err = 0;
+
+	for (int side = 0; side < ORIENTATION_SIDES; side++) {
+		if (!(captured_mask & BIT(side))) {
+			continue;
+		}
+
+		orientation_normal_set(side, &captured[side]);
+
+		snprintf(name, sizeof(name), "normal/%d", side);
+		err = settings_save_one(name, &captured[side], sizeof(captured[side]));
+		simulation_count(SIMULATION_SETTINGS_WRITE);
+		if (err) {
+			LOG_ERR("Failed to store %s, error: %d", name, err);
+			break;
+		}
+	}
+
+	LOG_INF("Calibration finished, %d of %d sides captured",
+		__builtin_popcount(captured_mask), ORIENTATION_SIDES);
+
+	captured_mask = 0;
+	atomic_set(&active, false);
+
+	/* Start over with the new normals */
+	orientation_init();
+
+	return err;
+}
+
+int calibration_update(void)
+{
+	int err;
+
+	if (!atomic_get(&stop_requested)) {
+		err = capture();
+		if (err) {
+			return err;
+		}
+
+		if (captured_mask != ALL_SIDES_MASK) {
+			return ORIENTATION_SIDES - __builtin_popcount(captured_mask);
+		}
+	}
+
+	return finish();
+}
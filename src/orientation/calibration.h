@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Calibration of the side normal vectors for the enclosure the device is mounted in.
+ *
+ * While calibration is active the device is put to rest on each side in turn, in side
+ * order starting at side 0. The filtered gravity vector is captured for the next side;
+ * a rest on a side that was already captured is rejected. When all sides are captured,
+ * or calibration is stopped, the captured normals replace the current ones and are
+ * stored under "normal/<side>" next to the "side_N" settings.
+ */
+
+#ifndef CALIBRATION_H__
+#define CALIBRATION_H__
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Register the settings handler that loads the stored normals. Must be called
+ *	  before settings_load().
+ *
+ * @return 0 on success or negative error value on failure.
+ */
+int calibration_init(void);
+
+/**
+ * @brief Start calibration.
+ *
+ * @details Can be called from interrupt context.
+ */
+void calibration_start(void);
+
+/**
+ * @brief Stop calibration. The sides captured so far are stored on the next call to
+ *	  calibration_update().
+ *
+ * @details Can be called from interrupt context.
+ */
+void calibration_stop(void);
+
+/**
+ * @brief Check if calibration is active.
+ *
+ * @return true if calibration is active.
+ */
+bool calibration_active(void);
+
+/**
+ * @brief Capture the filtered gravity vector of the side the device rests on, and store
+ *	  the captured normals once calibration is complete.
+ *
+ * @details Must be called from the thread running the orientation pipeline, after the
+ *	    device has come to rest.
+ *
+ * @return Number of sides left to capture, 0 when calibration is finished, -EAGAIN
+ *	   if the device was not resting on a side, -EALREADY if it rests on a side that
+ *	   was already captured, or another negative error value if the normals could not
+ *	   be stored.
+ */
+int calibration_update(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CALIBRATION_H__ */
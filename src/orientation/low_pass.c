@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+
+#include "low_pass.h"
+
+#define FRACTION_BITS 8
+
+void low_pass_init(struct low_pass *f, uint8_t shift)
+{
+	__ASSERT(shift <= 8, "Invalid shift");
+
+	f->state = 0;
+	f->shift = shift;
+	f->primed = false;
+}
+
+void low_pass_insert(struct low_pass *f, int16_t value)
+{
+	int32_t sample = (int32_t)value << FRACTION_BITS;
+
+	if (!f->primed) {
+		f->state = sample;
+		f->primed = true;
+		return;
+	}
+
+	f->state += (sample - f->state) >> f->shift;
+}
+
+int16_t low_pass_get(const struct low_pass *f)
+{
+	return (f->state + (1 << (FRACTION_BITS - 1))) >> FRACTION_BITS;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief First order low-pass filter for estimating gravity sample by sample.
+ */
+
+#ifndef LOW_PASS_H__
+#define LOW_PASS_H__
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Exponential moving average of a single axis.
+ *
+ *  Every sample moves the estimate by 1 / 2^shift of its distance to the sample, so
+ *  the time constant is 2^shift samples. The estimate keeps 8 fractional bits so
+ *  that small steps are not lost to rounding.
+ */
+struct low_pass {
+	/** Estimate with 8 fractional bits. */
+	int32_t state;
+	/** Smoothing, the weight of a new sample is 1 / 2^shift. */
+	uint8_t shift;
+	/** The estimate has been set by a sample. */
+	bool primed;
+};
+
+/**
+ * @brief Initialize the filter and forget the estimate.
+ *
+ * @param[out] f Filter to initialize.
+ * @param[in] shift Smoothing, 0 to 8. The weight of a new sample is 1 / 2^shift.
+ */
+void low_pass_init(struct low_pass *f, uint8_t shift);
+
+/**
+ * @brief Update the estimate with a sample. The first sample sets the estimate.
+ *
+ * @param[in,out] f Filter.
+ * @param[in] value New sample.
+ */
+void low_pass_insert(struct low_pass *f, int16_t value);
+
+/**
+ * @brief Get the estimate.
+ *
+ * @param[in] f Filter.
+ *
+ * @return Estimate, rounded to the nearest integer.
+ */
+int16_t low_pass_get(const struct low_pass *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOW_PASS_H__ */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <errno.h>
+#include <string.h>
+
+#include "orientation.h"
+#include "orientation_profile.h"
+#include "low_pass.h"
+#include "running_median.h"
+#include "side_classifier.h"
+
+/* Default normal vectors, and the side lookup table when enabled, generated at build
+ * time by scripts/gen_side_table.py from the normals of the enclosure geometry.
+ */
+#include "side_table.inc"
+
+BUILD_ASSERT(ARRAY_SIZE(side_table_normals) == ORIENTATION_SIDES);
+
+/* Normal vectors for each side in Q15, side 0 has no habit, used by the classifier.
+ * Sides that have been calibrated use their calibrated normal, the others the default.
+ */
+static struct side_normal normal_vectors[ORIENTATION_SIDES];
+
+/* Calibrated normals, staged until the next orientation_init() so the classifier never
+ * sees normals change under its cached state.
+ */
+static struct side_normal calibrated_normals[ORIENTATION_SIDES];
+static uint32_t calibrated_sides;
+
+BUILD_ASSERT(ORIENTATION_SIDES <= 32, "Calibrated sides do not fit in the mask");
+
+/* Gravity filters for each axis */
+#if defined(CONFIG_AWS_IOT_SAMPLE_ORIENTATION_FILTER_MEDIAN)
+static struct running_median axis_filter[3];
+#else
+static struct low_pass axis_filter[3];
+#endif
+
+static struct side_classifier classifier;
+
+/* Last filtered vector and its classification */
+static int16_t gravity[3];
+static int gravity_side = -1;
+static uint8_t gravity_confidence;
+
+ORIENTATION_PROFILE_DEFINE(gravity_filter);
+ORIENTATION_PROFILE_DEFINE(side_classifier);
+
+void orientation_init(void)
+{
+	for (int side = 0; side < ORIENTATION_SIDES; side++) {
+		if (calibrated_sides & BIT(side)) {
+			normal_vectors[side] = calibrated_normals[side];
+		} else {
+			normal_vectors[side] = side_table_normals[side];
+		}
+	}
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_ORIENTATION_LOOKUP_TABLE)
+	/* The table is generated from the defaults, calibrated normals that end up on
+	 * the other side of a bin are caught by the verification and scanned instead.
+	 */
+	side_classifier_init(&classifier, normal_vectors, ARRAY_SIZE(normal_vectors),
+			     side_table_lookup, SIDE_TABLE_LOOKUP_BINS);
+#else
+	side_classifier_init(&classifier, normal_vectors, ARRAY_SIZE(normal_vectors), NULL, 0);
+#endif
+	orientation_filter_reset();
+}
+
+void orientation_filter_reset(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(axis_filter); i++) {
+#if defined(CONFIG_AWS_IOT_SAMPLE_ORIENTATION_FILTER_MEDIAN)
+		running_median_init(&axis_filter[i],
+				    CONFIG_AWS_IOT_SAMPLE_ORIENTATION_WINDOW_SAMPLES);
+#else
+		low_pass_init(&axis_filter[i], CONFIG_AWS_IOT_SAMPLE_ORIENTATION_LOW_PASS_SHIFT);
+#endif
+	}
+}
+
+static void gravity_filter_update(const int16_t sample[3])
+{
+	for (size_t i = 0; i < ARRAY_SIZE(axis_filter); i++) {
+#if defined(CONFIG_AWS_IOT_SAMPLE_ORIENTATION_FILTER_MEDIAN)
+		running_median_insert(&axis_filter[i], sample[i]);
+		gravity[i] = running_median_get(&axis_filter[i]);
+#else
+		low_pass_insert(&axis_filter[i], sample[i]);
+		gravity[i] = low_pass_get(&axis_filter[i]);
+#endif
+	}
+}
+
+int orientation_update(const struct ext_sensor_accel_raw *sample, uint8_t *confidence)
+{
+	int16_t xyz[3] = {sample->x, sample->y, sample->z};
+	orientation_profile_stamp_t start;
+
+	/* The gravity estimate and the side are updated for every new sample. */
+	start = orientation_profile_start();
+	gravity_filter_update(xyz);
+	orientation_profile_stop(&gravity_filter, start);
+
+	start = orientation_profile_start();
+	gravity_side = side_classifier_update(&classifier, gravity, &gravity_confidence);
+	orientation_profile_stop(&side_classifier, start);
+
+	*confidence = gravity_confidence;
+	return gravity_side;
+}
+
+int orientation_gravity_get(int16_t vector[3], uint8_t *confidence)
+{
+	memcpy(vector, gravity, sizeof(gravity));
+	*confidence = gravity_confidence;
+	return gravity_side;
+}
+
+const struct side_classifier *orientation_classifier_get(void)
+{
+	return &classifier;
+}
+
+int orientation_normal_set(int side, const struct side_normal *normal)
+{
+	if (side < 0 || side >= ORIENTATION_SIDES) {
+		return -EINVAL;
+	}
+
+	calibrated_normals[side] = *normal;
+	calibrated_sides |= BIT(side);
+	return 0;
+}
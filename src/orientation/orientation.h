@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Orientation pipeline, from raw accelerometer samples to the side facing up.
+ */
+
+#ifndef ORIENTATION_H__
+#define ORIENTATION_H__
+
+#include <zephyr/types.h>
+
+#include "ext_sensors.h"
+#include "side_classifier.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of sides of the enclosure geometry. Side 0 has no habit. */
+#define ORIENTATION_SIDES CONFIG_AWS_IOT_SAMPLE_ORIENTATION_SIDES
+
+/** Number of samples after a filter reset before the gravity estimate has settled. */
+#if defined(CONFIG_AWS_IOT_SAMPLE_ORIENTATION_FILTER_MEDIAN)
+#define ORIENTATION_SETTLE_SAMPLES CONFIG_AWS_IOT_SAMPLE_ORIENTATION_WINDOW_SAMPLES
+#else
+/* Within 1 % of a step after 5 time constants */
+#define ORIENTATION_SETTLE_SAMPLES (5 << CONFIG_AWS_IOT_SAMPLE_ORIENTATION_LOW_PASS_SHIFT)
+#endif
+
+/**
+ * @brief Initialize the side classifier. The current side is forgotten.
+ */
+void orientation_init(void);
+
+/**
+ * @brief Forget the gravity estimate.
+ */
+void orientation_filter_reset(void);
+
+/**
+ * @brief Update the gravity estimate with a sample and classify it.
+ *
+ * @param[in] sample Raw accelerometer sample.
+ * @param[out] confidence Confidence of the returned side in percent, 0 if the filtered
+ *			  vector was rejected.
+ *
+ * @return The current side, or -1 if no side has been detected yet.
+ */
+int orientation_update(const struct ext_sensor_accel_raw *sample, uint8_t *confidence);
+
+/**
+ * @brief Get the last filtered vector and its classification.
+ *
+ * @param[out] vector Filtered gravity vector in raw accelerometer counts.
+ * @param[out] confidence Confidence of the returned side in percent.
+ *
+ * @return The current side, or -1 if no side has been detected yet.
+ */
+int orientation_gravity_get(int16_t vector[3], uint8_t *confidence);
+
+/**
+ * @brief Replace the normal vector of a side. The normal is staged and takes effect on
+ *	  the next call to orientation_init(), the running classifier is not changed.
+ *
+ * @param[in] side Side to update.
+ * @param[in] normal Unit normal vector in Q15.
+ *
+ * @return 0 on success or negative error value on failure.
+ */
+int orientation_normal_set(int side, const struct side_normal *normal);
+
+/**
+ * @brief Get the side classifier of the pipeline, for benchmarking.
+ *
+ * @return The side classifier.
+ */
+const struct side_classifier *orientation_classifier_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ORIENTATION_H__ */
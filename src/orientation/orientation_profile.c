@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+
+#include "orientation_profile.h"
+
+LOG_MODULE_REGISTER(orientation_profile, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+void orientation_profile_stop(struct orientation_profile *profile,
+			      orientation_profile_stamp_t start)
+{
+	orientation_profile_stamp_t end = timing_counter_get();
+	uint64_t cycles;
+
+	profile->cycles += timing_cycles_get(&start, &end);
+	profile->count++;
+
+	if (profile->count < CONFIG_AWS_IOT_SAMPLE_ORIENTATION_PROFILING_INTERVAL) {
+		return;
+	}
+
+	cycles = profile->cycles / profile->count;
+	LOG_INF("%s: %llu cycles (%llu ns) average over %u calls", profile->name, cycles,
+		timing_cycles_to_ns(cycles), profile->count);
+
+	profile->cycles = 0;
+	profile->count = 0;
+}
+
+static int orientation_profile_init(void)
+{
+	timing_init();
+	timing_start();
+	return 0;
+}
+
+SYS_INIT(orientation_profile_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
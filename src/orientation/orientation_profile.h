@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Cycle count profiling of the orientation pipeline.
+ */
+
+#ifndef ORIENTATION_PROFILE_H__
+#define ORIENTATION_PROFILE_H__
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Accumulated cycle counts of one pipeline stage. */
+struct orientation_profile {
+	/** Name used in the report. */
+	const char *name;
+	/** Cycles spent since the last report. */
+	uint64_t cycles;
+	/** Number of measurements since the last report. */
+	uint32_t count;
+};
+
+/** Define a profile for the pipeline stage @p _name. */
+#define ORIENTATION_PROFILE_DEFINE(_name)                                                          \
+	static struct orientation_profile _name = {.name = STRINGIFY(_name)}
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_ORIENTATION_PROFILING)
+#include <zephyr/timing/timing.h>
+
+typedef timing_t orientation_profile_stamp_t;
+
+/**
+ * @brief Start a measurement.
+ *
+ * @return Time stamp to pass to orientation_profile_stop().
+ */
+static inline orientation_profile_stamp_t orientation_profile_start(void)
+{
+	return timing_counter_get();
+}
+
+/**
+ * @brief Stop a measurement and add it to the profile. The average is logged every
+ *	  CONFIG_AWS_IOT_SAMPLE_ORIENTATION_PROFILING_INTERVAL measurements.
+ *
+ * @param[in,out] profile Profile of the measured stage.
+ * @param[in] start Time stamp returned by orientation_profile_start().
+ */
+void orientation_profile_stop(struct orientation_profile *profile,
+			      orientation_profile_stamp_t start);
+#else
+typedef uint32_t orientation_profile_stamp_t;
+
+static inline orientation_profile_stamp_t orientation_profile_start(void)
+{
+	return 0;
+}
+
+static inline void orientation_profile_stop(struct orientation_profile *profile,
+					    orientation_profile_stamp_t start)
+{
+	ARG_UNUSED(profile);
+	ARG_UNUSED(start);
+}
+#endif /* defined(CONFIG_AWS_IOT_SAMPLE_ORIENTATION_PROFILING) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ORIENTATION_PROFILE_H__ */
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/sys/__assert.h>
+
+#include "running_median.h"
+
+/* Heap positions are signed: the median is at 0, the max-heap of the lower half at
+ * negative positions and the min-heap of the upper half at positive positions.
+ * Children of position i are at 2i and 2i +/- 1, the parent is at i / 2.
+ */
+#define HEAP(m, i) ((m)->heap[(m)->window / 2 + (i)])
+#define VALUE(m, i) ((m)->data[HEAP(m, i)])
+
+static bool less(struct running_median *m, int i, int j)
+{
+	return VALUE(m, i) < VALUE(m, j);
+}
+
+static void exchange(struct running_median *m, int i, int j)
+{
+	uint8_t tmp = HEAP(m, i);
+
+	HEAP(m, i) = HEAP(m, j);
+	HEAP(m, j) = tmp;
+	m->pos[HEAP(m, i)] = i;
+	m->pos[HEAP(m, j)] = j;
+}
+
+/* Swap i and j if the item at i is smaller, returns true if they were swapped. */
+static bool compare_exchange(struct running_median *m, int i, int j)
+{
+	if (!less(m, i, j)) {
+		return false;
+	}
+
+	exchange(m, i, j);
+	return true;
+}
+
+/* Restore the min-heap property below position i. */
+static void min_sort_down(struct running_median *m, int i)
+{
+	for (i *= 2; i <= m->min_count; i *= 2) {
+		if (i < m->min_count && less(m, i + 1, i)) {
+			i++;
+		}
+		if (!compare_exchange(m, i, i / 2)) {
+			break;
+		}
+	}
+}
+
+/* Restore the max-heap property below position i. */
+static void max_sort_down(struct running_median *m, int i)
+{
+	for (i *= 2; i >= -m->max_count; i *= 2) {
+		if (i > -m->max_count && less(m, i, i - 1)) {
+			i--;
+		}
+		if (!compare_exchange(m, i / 2, i)) {
+			break;
+		}
+	}
+}
+
+/* Restore the min-heap property above position i, returns true if it reached the median. */
+static bool min_sort_up(struct running_median *m, int i)
+{
+	while (i > 0 && compare_exchange(m, i, i / 2)) {
+		i /= 2;
+	}
+
+	return i == 0;
+}
+
+/* Restore the max-heap property above position i, returns true if it reached the median. */
+static bool max_sort_up(struct running_median *m, int i)
+{
+	while (i < 0 && compare_exchange(m, i / 2, i)) {
+		i /= 2;
+	}
+
+	return i == 0;
+}
+
+void running_median_init(struct running_median *m, size_t window)
+{
+	__ASSERT(window > 0 && window <= RUNNING_MEDIAN_WINDOW_MAX, "Invalid window length");
+
+	m->window = window;
+	m->idx = 0;
+	m->min_count = 0;
+	m->max_count = 0;
+	m->count = 0;
+
+	/* Fill pattern for the first samples: median, max-heap, min-heap, max-heap, ... */
+	for (int i = window - 1; i >= 0; i--) {
+		m->pos[i] = ((i + 1) / 2) * ((i & 1) ? -1 : 1);
+		HEAP(m, m->pos[i]) = i;
+		m->data[i] = 0;
+	}
+}
+
+void running_median_insert(struct running_median *m, int16_t value)
+{
+	int p = m->pos[m->idx];
+	int16_t old = m->data[m->idx];
+
+	m->data[m->idx] = value;
+	m->idx = (m->idx + 1) % m->window;
+
+	if (m->count < m->window) {
+		m->count++;
+	}
+
+	if (p > 0) {
+		/* New sample is in the min-heap. */
+		if (m->min_count < (m->window - 1) / 2) {
+			m->min_count++;
+		} else if (value > old) {
+			min_sort_down(m, p);
+			return;
+		}
+		if (min_sort_up(m, p) && compare_exchange(m, 0, -1)) {
+			max_sort_down(m, -1);
+		}
+	} else if (p < 0) {
+		/* New sample is in the max-heap. */
+		if (m->max_count < m->window / 2) {
+			m->max_count++;
+		} else if (value < old) {
+			max_sort_down(m, p);
+			return;
+		}
+		if (max_sort_up(m, p) && m->min_count && compare_exchange(m, 1, 0)) {
+			min_sort_down(m, 1);
+		}
+	} else {
+		/* New sample replaced the median. */
+		if (m->max_count && max_sort_up(m, -1)) {
+			max_sort_down(m, -1);
+		}
+		if (m->min_count && min_sort_up(m, 1)) {
+			min_sort_down(m, 1);
+		}
+	}
+}
+
+int16_t running_median_get(const struct running_median *m)
+{
+	int32_t value = m->data[m->heap[m->window / 2]];
+
+	if (m->min_count < m->max_count) {
+		value = (value + m->data[m->heap[m->window / 2 - 1]]) / 2;
+	}
+
+	return value;
+}
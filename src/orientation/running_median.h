@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Sliding window median filter.
+ */
+
+#ifndef RUNNING_MEDIAN_H__
+#define RUNNING_MEDIAN_H__
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Largest supported window length. */
+#define RUNNING_MEDIAN_WINDOW_MAX 64
+
+/** @brief Sliding window median over the last samples of a single axis.
+ *
+ *  The window is kept as a max-heap of the lower half and a min-heap of the upper
+ *  half that share the median as their root, so inserting a sample and dropping
+ *  the oldest one costs O(log n).
+ */
+struct running_median {
+	/** Samples in insertion order. */
+	int16_t data[RUNNING_MEDIAN_WINDOW_MAX];
+	/** Heap position of each sample. */
+	int8_t pos[RUNNING_MEDIAN_WINDOW_MAX];
+	/** Heap of indexes into data, centered on heap[window / 2]. */
+	uint8_t heap[RUNNING_MEDIAN_WINDOW_MAX];
+	/** Window length. */
+	uint8_t window;
+	/** Next position to write in data. */
+	uint8_t idx;
+	/** Number of samples in the min-heap, excluding the median. */
+	uint8_t min_count;
+	/** Number of samples in the max-heap, excluding the median. */
+	uint8_t max_count;
+	/** Number of samples in the window. */
+	uint8_t count;
+};
+
+/**
+ * @brief Initialize the filter and empty the window.
+ *
+ * @param[out] m Filter to initialize.
+ * @param[in] window Number of samples in the window, 1 to RUNNING_MEDIAN_WINDOW_MAX.
+ */
+void running_median_init(struct running_median *m, size_t window);
+
+/**
+ * @brief Add a sample to the window, replacing the oldest one when it is full.
+ *
+ * @param[in,out] m Filter.
+ * @param[in] value New sample.
+ */
+void running_median_insert(struct running_median *m, int16_t value);
+
+/**
+ * @brief Get the median of the samples in the window.
+ *
+ * @param[in] m Filter.
+ *
+ * @return Median value, the mean of the two middle samples for even counts.
+ */
+int16_t running_median_get(const struct running_median *m);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RUNNING_MEDIAN_H__ */
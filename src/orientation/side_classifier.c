@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "side_classifier.h"
+#include "ext_sensors.h"
+#include "isqrt.h"
+
+/* 1 g in raw accelerometer counts. */
+#define ONE_G (1000 / EXT_SENSORS_ACCEL_RAW_MG_PER_LSB)
+
+#define GRAVITY_TOLERANCE                                                                          \
+	(CONFIG_AWS_IOT_SAMPLE_ORIENTATION_GRAVITY_TOLERANCE_MG / EXT_SENSORS_ACCEL_RAW_MG_PER_LSB)
+
+/* Dot products are in raw counts scaled by Q15. */
+#define HYSTERESIS                                                                                 \
+	((CONFIG_AWS_IOT_SAMPLE_ORIENTATION_HYSTERESIS_MG / EXT_SENSORS_ACCEL_RAW_MG_PER_LSB) << 15)
+
+static int32_t dot_product(const struct side_normal *normal, const int16_t vector[3])
+{
+	return (int32_t)normal->x * vector[0] + (int32_t)normal->y * vector[1] +
+	       (int32_t)normal->z * vector[2];
+}
+
+static uint8_t confidence_get(int32_t dot, uint32_t magnitude)
+{
+	int32_t cos = dot / (int32_t)magnitude;
+
+	return CLAMP((cos * 100) >> 15, 0, 100);
+}
+
+void side_classifier_init(struct side_classifier *c, const struct side_normal *normals,
+			  size_t count, const uint8_t *lookup, uint8_t bins)
+{
+	int32_t max_dot = 0;
+
+	c->normals = normals;
+	c->count = count;
+	c->lookup = lookup;
+	c->lookup_bins = bins;
+	c->side = -1;
+	c->confidence = 0;
+	memset(c->gravity, 0, sizeof(c->gravity));
+
+	for (size_t i = 0; i < count; i++) {
+		int16_t normal[3] = {normals[i].x, normals[i].y, normals[i].z};
+
+		for (size_t j = i + 1; j < count; j++) {
+			max_dot = MAX(max_dot, dot_product(&normals[j], normal));
+		}
+	}
+
+	/* cos(a / 2) = sqrt((1 + cos(a)) / 2), only evaluated once. */
+	c->stay_cos = sqrtf((1.0f + max_dot / (float)BIT(30)) / 2.0f) * BIT(15);
+}
+
+int side_classifier_scan(const struct side_classifier *c, const int16_t gravity[3],
+			 int32_t *dot)
+{
+	int32_t best_dot = INT32_MIN;
+	int best = 0;
+
+	for (size_t i = 0; i < c->count; i++) {
+		int32_t d = dot_product(&c->normals[i], gravity);
+
+		if (d > best_dot) {
+			best_dot = d;
+			best = i;
+		}
+	}
+
+	*dot = best_dot;
+	return best;
+}
+
+int side_classifier_lookup(const struct side_classifier *c, const int16_t gravity[3],
+			   int32_t *dot)
+{
+	uint32_t x = abs(gravity[0]);
+	uint32_t y = abs(gravity[1]);
+	uint32_t sum = x + y + abs(gravity[2]);
+	uint32_t u, v, octant;
+	int64_t magnitude_squared;
+	int side;
+
+	if (c->lookup == NULL || sum == 0) {
+		return -1;
+	}
+
+	octant = (gravity[0] < 0) << 2 | (gravity[1] < 0) << 1 | (gravity[2] < 0);
+	u = MIN(x * c->lookup_bins / sum, c->lookup_bins - 1U);
+	v = MIN(y * c->lookup_bins / sum, c->lookup_bins - 1U);
+
+	side = c->lookup[(octant * c->lookup_bins + u) * c->lookup_bins + v];
+	if (side >= (int)c->count) {
+		return -1;
+	}
+
+	/* dot > stay_cos * |gravity|, squared to avoid the square root. */
+	*dot = dot_product(&c->normals[side], gravity);
+	magnitude_squared = (int32_t)gravity[0] * gravity[0] + (int32_t)gravity[1] * gravity[1] +
+			    (int32_t)gravity[2] * gravity[2];
+
+	if (*dot <= 0 ||
+	    (int64_t)*dot * *dot <= (int64_t)c->stay_cos * c->stay_cos * magnitude_squared) {
+		return -1;
+	}
+
+	return side;
+}
+
+int side_classifier_update(struct side_classifier *c, const int16_t gravity[3],
+			   uint8_t *confidence)
+{
+	int32_t current_dot = 0;
+	int32_t best_dot;
+	int best;
+	uint32_t magnitude;
+
+	/* The filtered vector often repeats while the device lies still. */
+	if (memcmp(gravity, c->gravity, sizeof(c->gravity)) == 0) {
+		*confidence = c->confidence;
+		return c->side;
+	}
+
+	memcpy(c->gravity, gravity, sizeof(c->gravity));
+
+	magnitude = isqrt((int64_t)gravity[0] * gravity[0] + (int64_t)gravity[1] * gravity[1] +
+			  (int64_t)gravity[2] * gravity[2]);
+
+	/* Reject vectors that are not gravity alone, the device is moving. */
+	if (abs((int32_t)magnitude - ONE_G) > GRAVITY_TOLERANCE) {
+		c->confidence = 0;
+		*confidence = 0;
+		return c->side;
+	}
+
+	if (c->side >= 0) {
+		current_dot = dot_product(&c->normals[c->side], gravity);
+
+		/* Still within the cone around the current normal, no other side can be closer. */
+		if (current_dot > c->stay_cos * (int32_t)magnitude) {
+			c->confidence = confidence_get(current_dot, magnitude);
+			*confidence = c->confidence;
+			return c->side;
+		}
+	}
+
+	/* One table read and one dot product, the scan is only needed near the edges. */
+	best = side_classifier_lookup(c, gravity, &best_dot);
+	if (best < 0) {
+		best = side_classifier_scan(c, gravity, &best_dot);
+	}
+
+	if (c->side >= 0 && best != c->side && best_dot - current_dot < HYSTERESIS) {
+		best = c->side;
+		best_dot = current_dot;
+	}
+
+	c->side = best;
+	c->confidence = confidence_get(best_dot, magnitude);
+	*confidence = c->confidence;
+
+	return c->side;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Side classifier for the orientation of the device.
+ */
+
+#ifndef SIDE_CLASSIFIER_H__
+#define SIDE_CLASSIFIER_H__
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Convert a constant in the range [-1, 1) to Q15 fixed point. */
+#define Q15(x) ((int16_t)((x) * 32768.0 + ((x) < 0 ? -0.5 : 0.5)))
+
+/** @brief Unit normal vector of a side in Q15. */
+struct side_normal {
+	int16_t x;
+	int16_t y;
+	int16_t z;
+};
+
+/** @brief State of the side classifier. */
+struct side_classifier {
+	/** Normal vectors of the sides. */
+	const struct side_normal *normals;
+	/** Number of sides. */
+	size_t count;
+	/** Side lookup table, or NULL to always scan all normals. */
+	const uint8_t *lookup;
+	/** Bins per axis of the lookup table. */
+	uint8_t lookup_bins;
+	/** Cosine in Q15 of half the smallest angle between two normals. Gravity within
+	 *  this cone around a normal cannot be closer to any other normal.
+	 */
+	int32_t stay_cos;
+	/** Current side, or -1 if no side has been detected yet. */
+	int side;
+	/** Confidence of the current side. */
+	uint8_t confidence;
+	/** Last gravity vector that was classified. */
+	int16_t gravity[3];
+};
+
+/**
+ * @brief Initialize the classifier.
+ *
+ * @param[out] c Classifier to initialize.
+ * @param[in] normals Normal vectors of the sides.
+ * @param[in] count Number of sides.
+ * @param[in] lookup Side lookup table generated by scripts/gen_side_table.py from the
+ *		     same normals, or NULL. It holds 8 * bins * bins entries.
+ * @param[in] bins Bins per axis of the lookup table.
+ */
+void side_classifier_init(struct side_classifier *c, const struct side_normal *normals,
+			  size_t count, const uint8_t *lookup, uint8_t bins);
+
+/**
+ * @brief Find the side whose normal is closest to a vector by scanning all normals.
+ *
+ * @param[in] c Classifier.
+ * @param[in] gravity Gravity vector in raw accelerometer counts.
+ * @param[out] dot Dot product of gravity with the normal of the returned side.
+ *
+ * @return The closest side.
+ */
+int side_classifier_scan(const struct side_classifier *c, const int16_t gravity[3],
+			 int32_t *dot);
+
+/**
+ * @brief Find the side whose normal is closest to a vector with the lookup table.
+ *
+ * @details The side read from the table is verified with one dot product: it is only
+ *	    returned if gravity lies in the cone around its normal where no other normal
+ *	    can be closer, so the result always agrees with side_classifier_scan().
+ *
+ * @param[in] c Classifier.
+ * @param[in] gravity Gravity vector in raw accelerometer counts.
+ * @param[out] dot Dot product of gravity with the normal of the returned side.
+ *
+ * @return The closest side, or -1 if there is no lookup table or the side could not be
+ *	   verified.
+ */
+int side_classifier_lookup(const struct side_classifier *c, const int16_t gravity[3],
+			   int32_t *dot);
+
+/**
+ * @brief Classify a filtered gravity vector.
+ *
+ * @details The side whose normal has the largest dot product with gravity is selected.
+ *	    Vectors whose magnitude is too far from 1 g are rejected, and the side only
+ *	    changes when the new side beats the current one by the configured hysteresis.
+ *
+ * @param[in,out] c Classifier.
+ * @param[in] gravity Gravity vector in raw accelerometer counts.
+ * @param[out] confidence Alignment of gravity with the normal of the returned side in
+ *			  percent, 0 if the vector was rejected.
+ *
+ * @return The current side, or -1 if no side has been detected yet.
+ */
+int side_classifier_update(struct side_classifier *c, const int16_t gravity[3],
+			   uint8_t *confidence);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIDE_CLASSIFIER_H__ */
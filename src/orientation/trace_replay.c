@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/timing/timing.h>
+
+#include "orientation.h"
+#include "side_classifier.h"
+#include "trace_replay.h"
+
+LOG_MODULE_REGISTER(trace_replay, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+#define SAMPLE_PERIOD_MS CONFIG_AWS_IOT_SAMPLE_ORIENTATION_TRACE_SAMPLE_PERIOD_MS
+
+/* One recorded sample and the side that was up, or -1 while the device was moving. */
+struct trace_sample {
+	int16_t x;
+	int16_t y;
+	int16_t z;
+	int8_t side;
+};
+
+struct trace {
+	const char *name;
+	const struct trace_sample *samples;
+	size_t count;
+};
+
+/* Generated at build time from the CSV files in CONFIG_AWS_IOT_SAMPLE_ORIENTATION_TRACE_DIR. */
+#include "trace_data.inc"
+
+static void trace_replay_one(const struct trace *trace)
+{
+	uint32_t scored = 0;
+	uint32_t correct = 0;
+	uint32_t flips = 0;
+	uint32_t latency_sum = 0;
+	uint32_t latency_max = 0;
+	uint64_t cycles = 0;
+	int resting = -1;
+	int target = -1;
+	int flip_start = -1;
+
+	orientation_init();
+
+	for (size_t i = 0; i < trace->count; i++) {
+		const struct trace_sample *s = &trace->samples[i];
+		struct ext_sensor_accel_raw sample = {.x = s->x, .y = s->y, .z = s->z};
+		uint8_t confidence;
+		timing_t start, end;
+		int side;
+
+		start = timing_counter_get();
+		side = orientation_update(&sample, &confidence);
+		end = timing_counter_get();
+		cycles += timing_cycles_get(&start, &end);
+
+		/* A flip starts when the device leaves the side it was resting on. */
+		if (s->side != resting) {
+			if (flip_start < 0) {
+				flip_start = i;
+			}
+			if (s->side >= 0) {
+				resting = s->side;
+				target = s->side;
+			}
+		} else if (target < 0) {
+			/* Back on the side it started from, nothing to detect. */
+			flip_start = -1;
+		}
+
+		/* The flip is detected when the new side would be acted upon. */
+		if (target >= 0 && side == target &&
+		    confidence >= CONFIG_AWS_IOT_SAMPLE_ORIENTATION_MIN_CONFIDENCE) {
+			uint32_t latency = i - flip_start;
+
+			latency_sum += latency;
+			latency_max = MAX(latency_max, latency);
+			flips++;
+			target = -1;
+			flip_start = -1;
+		}
+
+		if (s->side >= 0) {
+			scored++;
+			correct += (side == s->side);
+		}
+	}
+
+	if (target >= 0) {
+		LOG_WRN("%s: flip to side %d was never detected", trace->name, target);
+	}
+
+	LOG_INF("%s: %zu samples, accuracy %u%%", trace->name, trace->count,
+		scored ? correct * 100 / scored : 0);
+	LOG_INF("%s: %u flips, latency %u ms average, %u ms max", trace->name, flips,
+		flips ? latency_sum * SAMPLE_PERIOD_MS / flips : 0, latency_max * SAMPLE_PERIOD_MS);
+	LOG_INF("%s: %llu cycles (%llu ns) per window", trace->name, cycles / trace->count,
+		timing_cycles_to_ns(cycles / trace->count));
+}
+
+/* Compare the side lookup table with the scan over all normals on the samples of a trace. */
+static void trace_replay_benchmark(const struct trace *trace)
+{
+	const struct side_classifier *c = orientation_classifier_get();
+	uint64_t scan_cycles = 0;
+	uint64_t lookup_cycles = 0;
+	uint32_t verified = 0;
+	uint32_t mismatches = 0;
+
+	for (size_t i = 0; i < trace->count; i++) {
+		const struct trace_sample *s = &trace->samples[i];
+		int16_t gravity[3] = {s->x, s->y, s->z};
+		int32_t scan_dot, lookup_dot;
+		int scan_side, lookup_side;
+		timing_t start, end;
+
+		start = timing_counter_get();
+		scan_side = side_classifier_scan(c, gravity, &scan_dot);
+		end = timing_counter_get();
+		scan_cycles += timing_cycles_get(&start, &end);
+
+		start = timing_counter_get();
+		lookup_side = side_classifier_lookup(c, gravity, &lookup_dot);
+		if (lookup_side < 0) {
+			lookup_side = side_classifier_scan(c, gravity, &lookup_dot);
+		} else {
+			verified++;
+		}
+		end = timing_counter_get();
+		lookup_cycles += timing_cycles_get(&start, &end);
+
+		mismatches += (lookup_side != scan_side);
+	}
+
+	LOG_INF("%s: scan %llu ns, lookup table %llu ns per classification", trace->name,
+		timing_cycles_to_ns(scan_cycles / trace->count),
+		timing_cycles_to_ns(lookup_cycles / trace->count));
+	LOG_INF("%s: %u%% verified by the lookup table, %u mismatches", trace->name,
+		(uint32_t)(verified * 100 / trace->count), mismatches);
+}
+
+void trace_replay_run(void)
+{
+	timing_init();
+	timing_start();
+
+	for (size_t i = 0; i < ARRAY_SIZE(traces); i++) {
+		trace_replay_one(&traces[i]);
+		trace_replay_benchmark(&traces[i]);
+	}
+
+	orientation_init();
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Replay of recorded accelerometer traces through the orientation pipeline.
+ */
+
+#ifndef TRACE_REPLAY_H__
+#define TRACE_REPLAY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Feed every built-in trace through the orientation pipeline and log the
+ *	  classification accuracy, the flip detection latency and the CPU time per window.
+ *	  The side lookup table is benchmarked against the scan over all normals.
+ *
+ * @details The orientation pipeline is reinitialized afterwards.
+ */
+void trace_replay_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_REPLAY_H__ */
@@ -4,30 +4,17 @@
 #define DEFAULT_TYPE_VALUE ""
 #define DEFAULT_ID_VALUE ""
 
-struct settings_data side_0_settings = { .id = DEFAULT_ID_VALUE, .type = DEFAULT_TYPE_VALUE };
-struct settings_data side_1_settings = { .id = DEFAULT_ID_VALUE, .type = DEFAULT_TYPE_VALUE };
-struct settings_data side_2_settings = { .id = DEFAULT_ID_VALUE, .type = DEFAULT_TYPE_VALUE };
-struct settings_data side_3_settings = { .id = DEFAULT_ID_VALUE, .type = DEFAULT_TYPE_VALUE };
-struct settings_data side_4_settings = { .id = DEFAULT_ID_VALUE, .type = DEFAULT_TYPE_VALUE };
-struct settings_data side_5_settings = { .id = DEFAULT_ID_VALUE, .type = DEFAULT_TYPE_VALUE };
-struct settings_data side_6_settings = { .id = DEFAULT_ID_VALUE, .type = DEFAULT_TYPE_VALUE };
-struct settings_data side_7_settings = { .id = DEFAULT_ID_VALUE, .type = DEFAULT_TYPE_VALUE };
-struct settings_data side_8_settings = { .id = DEFAULT_ID_VALUE, .type = DEFAULT_TYPE_VALUE };
-struct settings_data side_9_settings = { .id = DEFAULT_ID_VALUE, .type = DEFAULT_TYPE_VALUE };
-struct settings_data side_10_settings = { .id = DEFAULT_ID_VALUE, .type = DEFAULT_TYPE_VALUE };
+/* Habit settings of each side, stored under side_<n> */
+#define SIDE_SETTINGS_INIT(n, _) { .id = DEFAULT_ID_VALUE, .type = DEFAULT_TYPE_VALUE, .handle = 0 }
+
+static struct settings_data side_settings_data[MAX_SIDES] = {
+    LISTIFY(MAX_SIDES, SIDE_SETTINGS_INIT, (,))
+};
+
+#define SIDE_SETTINGS_PTR(n, _) &side_settings_data[n]
 
 struct settings_data *side_settings[MAX_SIDES] = {
-    &side_0_settings,
-    &side_1_settings,
-    &side_2_settings,
-    &side_3_settings,
-    &side_4_settings,
-    &side_5_settings,
-    &side_6_settings,
-    &side_7_settings,
-    &side_8_settings,
-    &side_9_settings,
-    &side_10_settings,
+    LISTIFY(MAX_SIDES, SIDE_SETTINGS_PTR, (,))
 };
 
 int side_config_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg, struct settings_data *side_settings) {
@@ -54,121 +41,37 @@ int side_config_settings_set(const char *name, size_t len, settings_read_cb read
             return 0;
         }
         return rc;
+    } else if (settings_name_steq(name, "handle", &next) && !next) {
+        if (len != sizeof(side_settings->handle)) {
+            return -EINVAL;
+        }
+
+        rc = read_cb(cb_arg, &side_settings->handle, sizeof(side_settings->handle));
+        if (rc >= 0) {
+            return 0;
+        }
+        return rc;
     }
 
     return -ENOENT;
 }
 
-int side_0_config_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
-    return side_config_settings_set(name, len, read_cb, cb_arg, &side_0_settings);
-}
-
-int side_1_config_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
-    return side_config_settings_set(name, len, read_cb, cb_arg, &side_1_settings);
-}
-
-int side_2_config_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
-    return side_config_settings_set(name, len, read_cb, cb_arg, &side_2_settings);
-}
-
-int side_3_config_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
-    return side_config_settings_set(name, len, read_cb, cb_arg, &side_3_settings);
-}
-
-int side_4_config_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
-    return side_config_settings_set(name, len, read_cb, cb_arg, &side_4_settings);
-}
-
-int side_5_config_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
-    return side_config_settings_set(name, len, read_cb, cb_arg, &side_5_settings);
-}
-
-int side_6_config_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
-    return side_config_settings_set(name, len, read_cb, cb_arg, &side_6_settings);
-}
-
-int side_7_config_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
-    return side_config_settings_set(name, len, read_cb, cb_arg, &side_7_settings);
-}
-
-int side_8_config_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
-    return side_config_settings_set(name, len, read_cb, cb_arg, &side_8_settings);
-}
-
-int side_9_config_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
-    return side_config_settings_set(name, len, read_cb, cb_arg, &side_9_settings);
-}
-
-int side_10_config_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
-    return side_config_settings_set(name, len, read_cb, cb_arg, &side_10_settings);
-}
-
-struct settings_handler side_0_conf = {
-    .name = "side_0",
-    .h_set = side_0_config_settings_set,
-};
-
-struct settings_handler side_1_conf = {
-    .name = "side_1",
-    .h_set = side_1_config_settings_set,
-};
-
-struct settings_handler side_2_conf = {
-    .name = "side_2",
-    .h_set = side_2_config_settings_set,
-};
-
-struct settings_handler side_3_conf = {
-    .name = "side_3",
-    .h_set = side_3_config_settings_set,
-};
+/* A settings handler per side, generated for the number of sides of the enclosure */
+#define SIDE_CONF_DEFINE(n, _)                                                                   \
+    static int side_##n##_config_settings_set(const char *name, size_t len,                      \
+                                              settings_read_cb read_cb, void *cb_arg) {          \
+        return side_config_settings_set(name, len, read_cb, cb_arg, &side_settings_data[n]);     \
+    }                                                                                            \
+                                                                                                 \
+    static struct settings_handler side_##n##_conf = {                                           \
+        .name = "side_" #n,                                                                      \
+        .h_set = side_##n##_config_settings_set,                                                 \
+    };
 
-struct settings_handler side_4_conf = {
-    .name = "side_4",
-    .h_set = side_4_config_settings_set,
-};
-
-struct settings_handler side_5_conf = {
-    .name = "side_5",
-    .h_set = side_5_config_settings_set,
-};
+LISTIFY(MAX_SIDES, SIDE_CONF_DEFINE, ())
 
-struct settings_handler side_6_conf = {
-    .name = "side_6",
-    .h_set = side_6_config_settings_set,
-};
-
-struct settings_handler side_7_conf = {
-    .name = "side_7",
-    .h_set = side_7_config_settings_set,
-};
-
-struct settings_handler side_8_conf = {
-    .name = "side_8",
-    .h_set = side_8_config_settings_set,
-};
-
-struct settings_handler side_9_conf = {
-    .name = "side_9",
-    .h_set = side_9_config_settings_set,
-};
-
-struct settings_handler side_10_conf = {
-    .name = "side_10",
-    .h_set = side_10_config_settings_set,
-};
+#define SIDE_CONF_PTR(n, _) &side_##n##_conf
 
 struct settings_handler *side_confs[MAX_SIDES] = {
-    &side_0_conf,
-    &side_1_conf,
-    &side_2_conf,
-    &side_3_conf,
-    &side_4_conf,
-    &side_5_conf,
-    &side_6_conf,
-    &side_7_conf,
-    &side_8_conf,
-    &side_9_conf,
-    &side_10_conf,
+    LISTIFY(MAX_SIDES, SIDE_CONF_PTR, (,))
 };
-
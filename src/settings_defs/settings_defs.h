@@ -2,39 +2,19 @@
 #define SETTINGS_DEFS_H
 
 #include <zephyr/settings/settings.h>
+#include <zephyr/sys/util_macro.h>
 #include <zephyr/types.h>
 
-#define MAX_SIDES 11
+/* Sides with a habit, side 0 of the enclosure has none. A literal so it can be listified. */
+#define MAX_SIDES UTIL_DEC(CONFIG_AWS_IOT_SAMPLE_ORIENTATION_SIDES)
 
 struct settings_data {
     char *id;
     char *type;
+    /* Handle of the habit assigned in the device shadow, 0 if none */
+    uint32_t handle;
 };
 
-extern struct settings_data side_0_settings;
-extern struct settings_data side_1_settings;
-extern struct settings_data side_2_settings;
-extern struct settings_data side_3_settings;
-extern struct settings_data side_4_settings;
-extern struct settings_data side_5_settings;
-extern struct settings_data side_6_settings;
-extern struct settings_data side_7_settings;
-extern struct settings_data side_8_settings;
-extern struct settings_data side_9_settings;
-extern struct settings_data side_10_settings;
-
-extern struct settings_handler side_0_conf;
-extern struct settings_handler side_1_conf;
-extern struct settings_handler side_2_conf;
-extern struct settings_handler side_3_conf;
-extern struct settings_handler side_4_conf;
-extern struct settings_handler side_5_conf;
-extern struct settings_handler side_6_conf;
-extern struct settings_handler side_7_conf;
-extern struct settings_handler side_8_conf;
-extern struct settings_handler side_9_conf;
-extern struct settings_handler side_10_conf;
-
 extern struct settings_handler *side_confs[MAX_SIDES];
 extern struct settings_data *side_settings[MAX_SIDES];
 
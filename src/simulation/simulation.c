@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/logging/log.h>
+
+#if defined(CONFIG_ARCH_POSIX)
+#include <posix_board_if.h>
+#endif
+
+#include "simulation.h"
+
+LOG_MODULE_REGISTER(simulation, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+#define REPORT_INTERVAL_MS ((int64_t)CONFIG_AWS_IOT_SAMPLE_SIMULATION_REPORT_HOURS * 3600 * 1000)
+#define DURATION_MS	   ((int64_t)CONFIG_AWS_IOT_SAMPLE_SIMULATION_DURATION_HOURS * 3600 * 1000)
+
+/* The heap of k_malloc(), which cJSON allocates from. */
+extern struct k_heap _system_heap;
+
+static atomic_t counters[SIMULATION_COUNTER_COUNT];
+
+static void report_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(report_work, report_work_fn);
+
+void simulation_count(enum simulation_counter counter)
+{
+	atomic_inc(&counters[counter]);
+}
+
+static void simulation_report(int64_t uptime)
+{
+	struct sys_memory_stats heap;
+
+	LOG_INF("Simulated %lld h %lld min", uptime / 3600000, (uptime / 60000) % 60);
+	LOG_INF("Published %ld messages, %ld failed, over %ld connections",
+		atomic_get(&counters[SIMULATION_PUBLISH]),
+		atomic_get(&counters[SIMULATION_PUBLISH_FAILED]),
+		atomic_get(&counters[SIMULATION_CONNECT]));
+	LOG_INF("Wrote %ld settings records", atomic_get(&counters[SIMULATION_SETTINGS_WRITE]));
+	LOG_INF("Wrote %ld event queue records, erased %ld event queue sectors",
+		atomic_get(&counters[SIMULATION_QUEUE_WRITE]),
+		atomic_get(&counters[SIMULATION_QUEUE_ERASE]));
+	LOG_INF("Counted %ld side changes and %ld impacts",
+		atomic_get(&counters[SIMULATION_SIDE_CHANGE]),
+		atomic_get(&counters[SIMULATION_IMPACT]));
+
+	if (sys_heap_runtime_stats_get(&_system_heap.heap, &heap) == 0) {
+		LOG_INF("Heap: %zu bytes allocated, %zu at most, %zu free",
+			heap.allocated_bytes, heap.max_allocated_bytes, heap.free_bytes);
+	}
+}
+
+static void report_work_fn(struct k_work *work)
+{
+	int64_t uptime = k_uptime_get();
+
+	simulation_report(uptime);
+
+	if (uptime < DURATION_MS) {
+		k_work_reschedule(&report_work,
+				  K_TIMEOUT_ABS_MS(MIN(uptime + REPORT_INTERVAL_MS, DURATION_MS)));
+		return;
+	}
+
+	LOG_INF("Simulation done");
+	LOG_PANIC();
+
+#if defined(CONFIG_ARCH_POSIX)
+	posix_exit(0);
+#endif
+}
+
+void simulation_start(void)
+{
+	k_work_reschedule(&report_work, K_TIMEOUT_ABS_MS(MIN(REPORT_INTERVAL_MS, DURATION_MS)));
+}
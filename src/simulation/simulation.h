@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Statistics of an accelerated-time simulation run.
+ *
+ * The application counts what it does through simulation_count(), which compiles to
+ * nothing unless CONFIG_AWS_IOT_SAMPLE_SIMULATION is enabled. The counts and the heap
+ * usage are logged once per simulated report interval and when the run ends.
+ */
+
+#ifndef SIMULATION_H__
+#define SIMULATION_H__
+
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Counted events. */
+enum simulation_counter {
+	/** Message handed to the MQTT client. */
+	SIMULATION_PUBLISH,
+	/** Message the MQTT client did not accept. */
+	SIMULATION_PUBLISH_FAILED,
+	/** Record written to the settings storage. */
+	SIMULATION_SETTINGS_WRITE,
+	/** Message or acknowledgment record written to the event queue. */
+	SIMULATION_QUEUE_WRITE,
+	/** Flash sector of the event queue erased. */
+	SIMULATION_QUEUE_ERASE,
+	/** New side declared by the orientation pipeline. */
+	SIMULATION_SIDE_CHANGE,
+	/** Impact counted by the habit counter. */
+	SIMULATION_IMPACT,
+	/** Connection to the broker established. */
+	SIMULATION_CONNECT,
+
+	SIMULATION_COUNTER_COUNT,
+};
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_SIMULATION)
+/**
+ * @brief Count one event.
+ *
+ * @details Can be called from any context.
+ *
+ * @param[in] counter Event.
+ */
+void simulation_count(enum simulation_counter counter);
+
+/**
+ * @brief Start the simulation reports.
+ *
+ * @details Logs a report every CONFIG_AWS_IOT_SAMPLE_SIMULATION_REPORT_HOURS and ends
+ *	    the run after CONFIG_AWS_IOT_SAMPLE_SIMULATION_DURATION_HOURS of uptime.
+ */
+void simulation_start(void);
+#else
+static inline void simulation_count(enum simulation_counter counter)
+{
+	ARG_UNUSED(counter);
+}
+
+static inline void simulation_start(void)
+{
+}
+#endif /* defined(CONFIG_AWS_IOT_SAMPLE_SIMULATION) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMULATION_H__ */
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+
+#include "tap_pattern.h"
+
+void tap_pattern_init(struct tap_pattern *tp, uint16_t gap)
+{
+	tp->last = 0;
+	tp->gap = gap;
+	tp->taps = 0;
+}
+
+enum tap_pattern_type tap_pattern_flush(struct tap_pattern *tp)
+{
+	uint8_t taps = tp->taps;
+
+	tp->taps = 0;
+
+	switch (taps) {
+	case 0:
+		return TAP_PATTERN_NONE;
+	case 1:
+		return TAP_PATTERN_SINGLE;
+	case 2:
+		return TAP_PATTERN_DOUBLE;
+	case 3:
+		return TAP_PATTERN_TRIPLE;
+	default:
+		return TAP_PATTERN_LONG;
+	}
+}
+
+enum tap_pattern_type tap_pattern_check(struct tap_pattern *tp, int64_t now)
+{
+	if (tp->taps == 0 || now - tp->last <= tp->gap) {
+		return TAP_PATTERN_NONE;
+	}
+
+	return tap_pattern_flush(tp);
+}
+
+enum tap_pattern_type tap_pattern_tap(struct tap_pattern *tp, int64_t timestamp)
+{
+	enum tap_pattern_type completed = tap_pattern_check(tp, timestamp);
+
+	tp->last = timestamp;
+	if (tp->taps < UINT8_MAX) {
+		tp->taps++;
+	}
+
+	return completed;
+}
+
+int64_t tap_pattern_deadline(const struct tap_pattern *tp)
+{
+	return tp->taps ? tp->last + tp->gap + 1 : -1;
+}
+
+const char *tap_pattern_name(enum tap_pattern_type type)
+{
+	switch (type) {
+	case TAP_PATTERN_SINGLE:
+		return "single tap";
+	case TAP_PATTERN_DOUBLE:
+		return "double tap";
+	case TAP_PATTERN_TRIPLE:
+		return "triple tap";
+	case TAP_PATTERN_LONG:
+		return "long tap sequence";
+	default:
+		return "none";
+	}
+}
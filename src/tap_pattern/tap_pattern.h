@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *@brief Recognition of tap patterns in a stream of impact timestamps.
+ *
+ * Taps closer together than the gap form one sequence. A sequence is complete once no
+ * tap has followed its last one for a whole gap, and is then classified by its number
+ * of taps. The engine only does arithmetic on timestamps, the caller decides when to
+ * check for a complete sequence.
+ */
+
+#ifndef TAP_PATTERN_H__
+#define TAP_PATTERN_H__
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Tap patterns. */
+enum tap_pattern_type {
+	TAP_PATTERN_NONE,
+	TAP_PATTERN_SINGLE,
+	TAP_PATTERN_DOUBLE,
+	TAP_PATTERN_TRIPLE,
+	/** Four or more taps in quick succession, the equivalent of holding a button. */
+	TAP_PATTERN_LONG,
+};
+
+/** @brief State of the engine. */
+struct tap_pattern {
+	/** Timestamp of the last tap of the current sequence in milliseconds. */
+	int64_t last;
+	/** Maximum time between two taps of a sequence in milliseconds. */
+	uint16_t gap;
+	/** Taps in the current sequence, 0 if there is none. */
+	uint8_t taps;
+};
+
+/**
+ * @brief Initialize the engine.
+ *
+ * @param[out] tp Engine.
+ * @param[in] gap Maximum time between two taps of a sequence in milliseconds.
+ */
+void tap_pattern_init(struct tap_pattern *tp, uint16_t gap);
+
+/**
+ * @brief Add a tap.
+ *
+ * @param[in,out] tp Engine.
+ * @param[in] timestamp Time of the tap in milliseconds, not before the previous one.
+ *
+ * @return The sequence completed by the gap before this tap, or TAP_PATTERN_NONE if the
+ *	   tap continues the current sequence.
+ */
+enum tap_pattern_type tap_pattern_tap(struct tap_pattern *tp, int64_t timestamp);
+
+/**
+ * @brief Complete the current sequence if its gap has passed.
+ *
+ * @param[in,out] tp Engine.
+ * @param[in] now Current time in milliseconds.
+ *
+ * @return The completed sequence, or TAP_PATTERN_NONE if there is none or it may still
+ *	   be continued.
+ */
+enum tap_pattern_type tap_pattern_check(struct tap_pattern *tp, int64_t now);
+
+/**
+ * @brief Complete the current sequence right away.
+ *
+ * @param[in,out] tp Engine.
+ *
+ * @return The completed sequence, or TAP_PATTERN_NONE if there is none.
+ */
+enum tap_pattern_type tap_pattern_flush(struct tap_pattern *tp);
+
+/**
+ * @brief Time at which the current sequence is complete.
+ *
+ * @param[in] tp Engine.
+ *
+ * @return Time in milliseconds, or -1 if there is no sequence.
+ */
+int64_t tap_pattern_deadline(const struct tap_pattern *tp);
+
+/**
+ * @brief Name of a pattern, for logging.
+ *
+ * @param[in] type Pattern.
+ *
+ * @return Name.
+ */
+const char *tap_pattern_name(enum tap_pattern_type type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAP_PATTERN_H__ */